@@ -0,0 +1,165 @@
+/// @brief - Compares the batched conversion of tile coordinates to
+/// pixels with the per-tile one, for both kinds of frames.
+
+# include <core_utils/StdLogger.hh>
+# include <core_utils/PrefixedLogger.hh>
+# include <core_utils/LoggerLocator.hh>
+# include <chrono>
+# include <cmath>
+# include <memory>
+# include <string>
+# include <vector>
+# include <algorithm>
+# include "TopViewFrame.hh"
+# include "IsometricViewFrame.hh"
+
+using namespace pge::coordinates;
+
+namespace {
+
+  /// @brief - The size of the area converted at each pass, which
+  /// matches a view of 200x200 tiles.
+  constexpr auto AREA_SIZE = 200;
+
+  /// @brief - The number of times each conversion is repeated. The
+  /// fastest repetition is reported.
+  constexpr auto REPETITIONS = 50;
+
+  /// @brief - The tiles of the area, as a structure of arrays.
+  struct Tiles {
+    std::vector<float> xs;
+    std::vector<float> ys;
+  };
+
+  Tiles
+  generateTiles() {
+    Tiles out;
+
+    for (int y = 0 ; y < AREA_SIZE ; ++y) {
+      for (int x = 0 ; x < AREA_SIZE ; ++x) {
+        out.xs.push_back(static_cast<float>(x - AREA_SIZE / 2));
+        out.ys.push_back(static_cast<float>(y - AREA_SIZE / 2));
+      }
+    }
+
+    return out;
+  }
+
+  /// @brief - Runs the input conversion several times and returns
+  /// the duration of the fastest run in milliseconds.
+  template <typename Conversion>
+  float
+  measure(Conversion&& conversion) {
+    float best = 0.0f;
+
+    for (int id = 0 ; id < REPETITIONS ; ++id) {
+      const auto start = std::chrono::steady_clock::now();
+      conversion();
+      const auto end = std::chrono::steady_clock::now();
+
+      const auto elapsed = std::chrono::duration<float, std::milli>(end - start).count();
+      best = (id == 0 ? elapsed : std::min(best, elapsed));
+    }
+
+    return best;
+  }
+
+  /// @brief - Converts the tiles one at a time through the interface
+  /// of the frame, as the renderer used to do.
+  void
+  convertPerTile(const Frame& frame,
+                 const Tiles& tiles,
+                 Tiles& pixels)
+  {
+    for (unsigned id = 0u ; id < tiles.xs.size() ; ++id) {
+      const auto p = frame.tileCoordsToPixels(tiles.xs[id], tiles.ys[id]);
+      pixels.xs[id] = p.x;
+      pixels.ys[id] = p.y;
+    }
+  }
+
+  /// @brief - Converts all the tiles with a single call.
+  void
+  convertBatched(const Frame& frame,
+                 const Tiles& tiles,
+                 Tiles& pixels)
+  {
+    frame.batchTileCoordsToPixels(
+      tiles.xs.data(),
+      tiles.ys.data(),
+      pixels.xs.data(),
+      pixels.ys.data(),
+      static_cast<unsigned>(tiles.xs.size())
+    );
+  }
+
+  /// @brief - Returns the largest distance between the positions
+  /// produced by both conversions.
+  float
+  maxDifference(const Tiles& lhs, const Tiles& rhs) {
+    float out = 0.0f;
+
+    for (unsigned id = 0u ; id < lhs.xs.size() ; ++id) {
+      out = std::max(out, std::abs(lhs.xs[id] - rhs.xs[id]));
+      out = std::max(out, std::abs(lhs.ys[id] - rhs.ys[id]));
+    }
+
+    return out;
+  }
+
+  void
+  benchmark(const std::string& name,
+            const Frame& frame,
+            utils::PrefixedLogger& logger)
+  {
+    const Tiles tiles = generateTiles();
+
+    Tiles perTile{
+      std::vector<float>(tiles.xs.size()),
+      std::vector<float>(tiles.ys.size())
+    };
+    Tiles batched = perTile;
+
+    const auto perTileTime = measure([&]() { convertPerTile(frame, tiles, perTile); });
+    const auto batchedTime = measure([&]() { convertBatched(frame, tiles, batched); });
+
+    logger.logMessage(
+      utils::Level::Notice,
+      name + ": " + std::to_string(tiles.xs.size()) + " tile(s), " +
+      "per tile: " + std::to_string(perTileTime) + "ms, " +
+      "batched: " + std::to_string(batchedTime) + "ms, " +
+      "speedup: " + std::to_string(batchedTime > 0.0f ? perTileTime / batchedTime : 0.0f) + ", " +
+      "max difference: " + std::to_string(maxDifference(perTile, batched)) + " pixel(s)"
+    );
+  }
+
+}
+
+int
+main(int /*argc*/, char** /*argv*/) {
+  // Create the logger.
+  utils::StdLogger raw;
+  raw.setLevel(utils::Level::Notice);
+  utils::PrefixedLogger logger("pge", "bench");
+  utils::LoggerLocator::provide(&raw);
+
+  const auto tiles = ViewportF(
+    olc::vf2d(0.0f, 0.0f),
+    olc::vf2d(20.0f, 15.0f)
+  );
+  const auto pixels = ViewportF(
+    olc::vf2d(0.0f, 0.0f),
+    olc::vf2d(800.0f, 600.0f),
+    ViewportMode::TOP_LEFT_BASED
+  );
+
+  // Frames are used through their interface so that the
+  // per tile conversion goes through a virtual call.
+  const std::unique_ptr<Frame> top = std::make_unique<TopViewFrame>(tiles, pixels);
+  const std::unique_ptr<Frame> iso = std::make_unique<IsometricViewFrame>(tiles, pixels);
+
+  benchmark("top view", *top, logger);
+  benchmark("isometric view", *iso, logger);
+
+  return EXIT_SUCCESS;
+}
@@ -5,21 +5,91 @@
 # include <core_utils/PrefixedLogger.hh>
 # include <core_utils/LoggerLocator.hh>
 # include <core_utils/CoreException.hh>
+# include <string>
+# include <vector>
+# include <algorithm>
 # include "AppDesc.hh"
 # include "TopViewFrame.hh"
 # include "IsometricViewFrame.hh"
 # include "App.hh"
+# include "Trace.hh"
+# include "Log.hh"
+# include "Textures.hh"
 
 using namespace pge::coordinates;
 
+namespace {
+
+  /// @brief - Used to print statistics about the duration of the
+  /// frames of a run.
+  void
+  printTimings(const std::vector<float>& timings,
+               utils::PrefixedLogger& logger)
+  {
+    if (timings.empty()) {
+      return;
+    }
+
+    std::vector<float> sorted(timings);
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto percentile = [&sorted](float p) {
+      const auto id = static_cast<unsigned>(p * (sorted.size() - 1u) + 0.5f);
+      return sorted[id];
+    };
+
+    logger.logMessage(
+      utils::Level::Notice,
+      "Ran " + std::to_string(sorted.size()) + " frame(s): " +
+      "min: " + std::to_string(sorted.front()) + "ms, " +
+      "median: " + std::to_string(percentile(0.5f)) + "ms, " +
+      "p99: " + std::to_string(percentile(0.99f)) + "ms"
+    );
+  }
+
+  /// @brief - Used to print the number of allocations of the frames
+  /// of a run. The first frame is reported separately as it creates
+  /// the resources reused by the next ones. The frames where a pack
+  /// decoded in the background is built also allocate its textures.
+  void
+  printAllocations(const std::vector<std::uint64_t>& allocations,
+                   utils::PrefixedLogger& logger)
+  {
+    if (allocations.empty()) {
+      return;
+    }
+
+    const auto steady = std::vector<std::uint64_t>(allocations.begin() + 1, allocations.end());
+    const auto max = std::max_element(steady.begin(), steady.end());
+    const auto frames = std::count_if(steady.begin(), steady.end(), [](std::uint64_t c) { return c > 0u; });
+
+    logger.logMessage(
+      utils::Level::Notice,
+      "Allocations: first frame: " + std::to_string(allocations.front()) + ", " +
+      "max: " + std::to_string(max != steady.end() ? *max : 0u) + " " +
+      "in " + std::to_string(frames) + " of the next " + std::to_string(steady.size()) + " frame(s)"
+    );
+  }
+
+}
+
 int
-main(int /*argc*/, char** /*argv*/) {
+main(int argc, char** argv) {
   // Create the logger.
   utils::StdLogger raw;
   raw.setLevel(utils::Level::Debug);
   utils::PrefixedLogger logger("pge", "main");
   utils::LoggerLocator::provide(&raw);
 
+  // Messages from the app are formatted and logged
+  // in the background.
+  pge::log::setLevel(utils::Level::Debug);
+  pge::log::start();
+
+  // Images are decoded in the background and sent to
+  // the renderer by the app.
+  pge::textures::start();
+
   try {
     logger.logMessage(utils::Level::Notice, "Starting application");
 
@@ -38,9 +108,61 @@ main(int /*argc*/, char** /*argv*/) {
     auto cf = std::make_shared<IsometricViewFrame>(tiles, pixels);
     // auto cf = std::make_shared<TopViewFrame>(tiles, pixels);
     pge::AppDesc ad = pge::newDesc(olc::vi2d(800, 600), cf, "isometric");
+
+    // Layers to save once the app is stopped.
+    std::vector<std::string> dumps;
+
+    // File where the trace is saved once the app is
+    // stopped. Tracing is disabled when it is empty.
+    std::string traceFile;
+
+    for (int id = 1 ; id < argc ; ++id) {
+      const std::string arg(argv[id]);
+      const bool hasValue = (id + 1 < argc);
+
+      if (arg == "--headless") {
+        ad.headless = true;
+      }
+      else if (arg == "--frames" && hasValue) {
+        ad.frames = std::stoul(argv[++id]);
+      }
+      else if (arg == "--dt" && hasValue) {
+        ad.timestep = std::stof(argv[++id]);
+      }
+      else if (arg == "--dump" && hasValue) {
+        dumps.push_back(argv[++id]);
+      }
+      else if (arg == "--trace" && hasValue) {
+        traceFile = argv[++id];
+        pge::trace::enable(true);
+      }
+      else {
+        logger.logMessage(utils::Level::Warning, "Ignoring unknown argument \"" + arg + "\"");
+      }
+    }
+
     pge::App demo(ad);
 
     demo.Start();
+
+    printTimings(demo.timings(), logger);
+    printAllocations(demo.allocations(), logger);
+
+    if (!traceFile.empty()) {
+      if (pge::trace::save(traceFile)) {
+        logger.logMessage(utils::Level::Info, "Saved trace to \"" + traceFile + "\"");
+      }
+      else {
+        logger.logMessage(utils::Level::Error, "Failed to save trace to \"" + traceFile + "\"");
+      }
+    }
+
+    for (const auto& layer : dumps) {
+      const std::string file = layer + ".png";
+      if (demo.dumpLayer(layer, file)) {
+        logger.logMessage(utils::Level::Info, "Saved layer \"" + layer + "\" to \"" + file + "\"");
+      }
+    }
   }
   catch (const utils::CoreException& e) {
     logger.logError(utils::Level::Critical, "Caught internal exception while setting up application", e.what());
@@ -52,5 +174,8 @@ main(int /*argc*/, char** /*argv*/) {
     logger.logMessage(utils::Level::Critical, "Unexpected error while setting up application");
   }
 
+  pge::textures::stop();
+  pge::log::stop();
+
   return EXIT_SUCCESS;
 }
@@ -2,43 +2,39 @@
 # include "App.hh"
 # include "TopViewFrame.hh"
 # include "IsometricViewFrame.hh"
+# include "Log.hh"
 
 // # define SQUARES
 
 namespace {
-# ifdef SQUARES
+
   olc::Pixel
-  colorFromCoord(const int x, const int y) {
-    constexpr auto size = 4;
+  colorFromTile(const pge::TileType type) {
     static const auto colors = std::vector<olc::Pixel>{
-      olc::VERY_DARK_RED,
-      olc::VERY_DARK_BLUE,
-      olc::VERY_DARK_GREEN,
-      olc::VERY_DARK_YELLOW,
-      olc::VERY_DARK_MAGENTA,
-      olc::VERY_DARK_CYAN,
-      olc::VERY_DARK_GREY,
-      olc::WHITE,
-      olc::VERY_DARK_ORANGE,
-      olc::VERY_DARK_APPLE_GREEN,
-      olc::VERY_DARK_COBALT_BLUE,
-      olc::VERY_DARK_PURPLE,
-      olc::VERY_DARK_PINK,
-      olc::VERY_DARK_BROWN,
-      olc::VERY_DARK_CORNFLOWER_BLUE,
-      olc::VERY_DARK_BIDOOF
+      olc::RED,
+      olc::BLUE,
+      olc::GREEN,
+      olc::YELLOW
     };
 
-    if (x < -10 || x > 15) {
-      return olc::BLACK;
-    }
-    if (y < -20 || y > 3) {
-      return olc::VERY_DARK_GREY;
-    }
+    return colors[(type - 1u) % colors.size()];
+  }
 
-    return colors[((y % size) * 4 + (x % size)) % colors.size()];
+  /// @brief - Same as `toString` but writes the text in the output
+  /// string, which avoids allocating once it is large enough.
+  template <typename CoordinateType>
+  const std::string&
+  describe(std::string& out,
+           const char* label,
+           const olc::v2d_generic<CoordinateType>& vec)
+  {
+    out.assign(label);
+    out.append("[x: ").append(std::to_string(vec.x));
+    out.append(", y: ").append(std::to_string(vec.y)).append("]");
+
+    return out;
   }
-# endif
+
 }
 
 namespace pge {
@@ -49,11 +45,16 @@ namespace pge {
     m_game(nullptr),
     m_state(nullptr),
     m_menus(),
+    m_actions(),
 
     m_packs(std::make_shared<TexturePack>()),
     m_planetPackID(),
 
-    m_isometric(true)
+    m_chunks(colorFromTile),
+
+    m_isometric(true),
+
+    m_debugText()
   {}
 
   bool
@@ -81,22 +82,19 @@ namespace pge {
 
     // Handle menus update and process the
     // corresponding actions.
-    std::vector<ActionShPtr> actions;
     bool relevant = false;
 
     for (unsigned id = 0u ; id < m_menus.size() ; ++id) {
-      menu::InputHandle ih = m_menus[id]->processUserInput(c, actions);
+      menu::InputHandle ih = m_menus[id]->processUserInput(c, m_actions);
       relevant = (relevant || ih.relevant);
     }
 
     if (m_state != nullptr) {
-      menu::InputHandle ih = m_state->processUserInput(c, actions);
+      menu::InputHandle ih = m_state->processUserInput(c, m_actions);
       relevant = (relevant || ih.relevant);
     }
 
-    for (unsigned id = 0u ; id < actions.size() ; ++id) {
-      actions[id]->apply(*m_game);
-    }
+    m_actions.apply(*m_game);
 
     bool lClick = (c.buttons[controls::mouse::Left] == controls::ButtonState::Released);
     if (lClick && !relevant) {
@@ -127,6 +125,22 @@ namespace pge {
     }
   }
 
+  void
+  App::onFrameChanged(const coordinates::FrameChange& change) {
+    // Panning keeps the position of the tiles relatively
+    // to their chunk: the render lists are still valid.
+    if (change != coordinates::FrameChange::Pan) {
+      m_chunks.invalidate();
+    }
+  }
+
+  bool
+  App::uiRequired() const noexcept {
+    // The screens other than the game are made of
+    // menus only: they should stay visible.
+    return m_state != nullptr && m_state->getScreen() != Screen::Game;
+  }
+
   void
   App::loadData() {
     // Create the game and its state.
@@ -184,6 +198,10 @@ namespace pge {
 # else
   App::drawDecal(const RenderDesc& /*res*/) {
 # endif
+    // Build the packs whose image was decoded in the
+    // background: until then they use a placeholder.
+    m_packs->update();
+
     // Clear rendering target.
     SetPixelMode(olc::Pixel::ALPHA);
     Clear(olc::VERY_DARK_GREY);
@@ -194,39 +212,49 @@ namespace pge {
       return;
     }
 
-# ifdef SQUARES
-    const auto viewport = res.cf.cellsViewport();
-    const auto bl = viewport.bottomLeft();
-    const auto tr = viewport.topRight();
+    // Sprites are grouped by texture pack and drawn once
+    // all of them are known.
+    m_packs->beginBatch(&frameArena());
 
-    for (int y = bl.y ; y < tr.y ; ++y) {
-      for (int x = bl.x ; x < tr.x ; ++x) {
-        const auto c = colorFromCoord(x, y);
-        const auto pos = res.cf.tileCoordsToPixels(x, y);
-        const auto scale = res.cf.tilesToPixels();
+# ifdef SQUARES
+    // Tiles are filled with a single color.
+    const std::array<olc::vf2d, 4> uvs = {};
+    const auto screen = coordinates::ViewportF(
+      olc::vf2d(0.0f, 0.0f),
+      olc::vf2d(ScreenWidth(), ScreenHeight()),
+      coordinates::ViewportMode::TOP_LEFT_BASED
+    );
 
-        FillRectDecal(pos, scale, c);
+    m_chunks.render(
+      m_game->world(),
+      res.cf,
+      screen,
+      &frameArena(),
+      [this, &uvs](const ChunkRenderList& list, const olc::vf2d& anchor) {
+        std::array<olc::vf2d, 4> quad;
+
+        for (unsigned id = 0u ; id < list.offsets.size() ; id += quad.size()) {
+          for (unsigned c = 0u ; c < quad.size() ; ++c) {
+            quad[c] = anchor + list.offsets[id + c];
+          }
+
+          DrawExplicitDecal(nullptr, quad.data(), uvs.data(), &list.colors[id]);
+        }
       }
-    }
+    );
 # endif
 
+    m_packs->flush(this);
+
     SetPixelMode(olc::Pixel::NORMAL);
   }
 
   void
   App::draw(const RenderDesc& /*res*/) {
-    // Clear rendering target.
+    // Clear rendering target. The screens other than
+    // the game are drawn in the UI layer.
     SetPixelMode(olc::Pixel::ALPHA);
     Clear(olc::Pixel(255, 255, 255, alpha::Transparent));
-
-    // In case we're not in game mode, just render
-    // the state.
-    if (m_state->getScreen() != Screen::Game) {
-      m_state->render(this);
-      SetPixelMode(olc::Pixel::NORMAL);
-      return;
-    }
-
     SetPixelMode(olc::Pixel::NORMAL);
   }
 
@@ -258,10 +286,9 @@ namespace pge {
     SetPixelMode(olc::Pixel::ALPHA);
     Clear(olc::Pixel(255, 255, 255, alpha::Transparent));
 
-    // In case we're not in game mode, just render
-    // the state.
+    // In case we're not in game mode there is nothing
+    // to debug: the state is drawn in the UI layer.
     if (m_state->getScreen() != Screen::Game) {
-      m_state->render(this);
       SetPixelMode(olc::Pixel::NORMAL);
       return;
     }
@@ -273,9 +300,10 @@ namespace pge {
 
     int h = GetDrawTargetHeight();
     int dOffset = 15;
-    DrawString(olc::vi2d(0, h / 2), "Mouse coords      : " + toString(mp), olc::CYAN);
-    DrawString(olc::vi2d(0, h / 2 + 1 * dOffset), "World cell coords : " + toString(mtp), olc::CYAN);
-    DrawString(olc::vi2d(0, h / 2 + 2 * dOffset), "Intra cell        : " + toString(it), olc::CYAN);
+    std::string& text = m_debugText;
+    DrawString(olc::vi2d(0, h / 2), describe(text, "Mouse coords      : ", mp), olc::CYAN);
+    DrawString(olc::vi2d(0, h / 2 + 1 * dOffset), describe(text, "World cell coords : ", mtp), olc::CYAN);
+    DrawString(olc::vi2d(0, h / 2 + 2 * dOffset), describe(text, "Intra cell        : ", it), olc::CYAN);
 
     // const auto pos = res.cf.tileCoordsToPixels(mtp.x, mtp.y);
     // FillRectDecal(pos, res.cf.tilesToPixels(), olc::Pixel(255, 255, 0, alpha::SemiOpaque));
@@ -288,25 +316,36 @@ namespace pge {
     //   olc::ORANGE
     // );
 
-    const olc::vf2d tl = res.cf.tileCoordsToPixels(mtp, coordinates::TileLocation::TopLeft);
-    const olc::vf2d tr = res.cf.tileCoordsToPixels(mtp, coordinates::TileLocation::TopRight);
-    const olc::vf2d br = res.cf.tileCoordsToPixels(mtp, coordinates::TileLocation::BottomRight);
-    const olc::vf2d bl = res.cf.tileCoordsToPixels(mtp, coordinates::TileLocation::BottomLeft);
+    const auto quad = res.cf.tileQuad(mtp);
+    const olc::vf2d& tl = quad[0];
+    const olc::vf2d& bl = quad[1];
+    const olc::vf2d& br = quad[2];
+    const olc::vf2d& tr = quad[3];
     // const olc::vf2d tl(200.0f, 100.0f);
     // const olc::vf2d bl(tl.x, tl.y + 100.0f);
     // const olc::vf2d br(tl.x + 100.0f, tl.y + 100.0f);
     // const olc::vf2d tr(tl.x + 100.0f, tl.y);
 
-    log(
-      "p: " + mtp.str() +
-      " decal: " + tl.str() + "/" + res.cf.tileCoordsToPixels(mtp.x, mtp.y).str() +
-      " - " + tr.str() +
-      " -- " + bl.str() +
-      " - " + br.str()
+    PGE_DEBUG(
+      "p: ", mtp,
+      " decal: ", tl, "/", res.cf.tileCoordsToPixels(mtp.x, mtp.y),
+      " - ", tr,
+      " -- ", bl,
+      " - ", br
+    );
+    // Pick the version of the planet matching the size of
+    // the tile on screen.
+    const olc::vf2d ts = res.cf.tilesToPixels();
+    const olc::vi2d ps = m_packs->getRegionForPack(m_planetPackID).size;
+    const atlas::Region& planet = m_packs->getRegionForPack(
+      m_planetPackID,
+      olc::vf2d(ts.x / ps.x, ts.y / ps.y)
     );
-    DrawWarpedDecal(
-      m_packs->getDecalForPack(m_planetPackID),
-      {tl, bl, br, tr},
+    DrawPartialWarpedDecal(
+      planet.res,
+      quad,
+      planet.pos,
+      planet.size,
       olc::ORANGE
     );
 
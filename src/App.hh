@@ -6,6 +6,7 @@
 # include "Menu.hh"
 # include "Game.hh"
 # include "GameState.hh"
+# include "ChunkRenderCache.hh"
 
 namespace pge {
 
@@ -61,6 +62,12 @@ namespace pge {
       onInputs(const controls::State& c,
                const coordinates::Frame& cf) override;
 
+      void
+      onFrameChanged(const coordinates::FrameChange& change) override;
+
+      bool
+      uiRequired() const noexcept override;
+
     private:
 
       /// @brief - Convenience structure regrouping needed props to
@@ -122,14 +129,26 @@ namespace pge {
       /// @brief - Defines the list of menus available for this app.
       std::vector<MenuShPtr> m_menus;
 
+      /// @brief - The actions produced by the menus in response to the
+      /// inputs, waiting to be applied to the game.
+      ActionQueue m_actions;
+
       /// @brief - A description of the textures used to represent the
       /// elements of the game.
       TexturePackShPtr m_packs;
 
       unsigned m_planetPackID;
 
+      /// @brief - The render lists of the chunks of the world. They are
+      /// only rebuilt when the chunks change or when the frame is zoomed.
+      ChunkRenderCache m_chunks;
+
       /// @brief - The current frame used.
       bool m_isometric;
+
+      /// @brief - The text displayed by the debug layer. It is kept so
+      /// that its memory is reused from one frame to the next.
+      std::string m_debugText;
   };
 
 }
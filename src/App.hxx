@@ -2,7 +2,7 @@
 # define   APP_HXX
 
 # include "App.hh"
-# include "Action.hh"
+# include "ActionQueue.hh"
 
 namespace pge {
 
@@ -0,0 +1,87 @@
+
+# include "Allocations.hh"
+# include <new>
+# include <cstdlib>
+
+namespace {
+
+  thread_local std::uint64_t allocated = 0u;
+
+# if defined(PGE_COUNT_ALLOCATIONS)
+  void*
+  allocate(std::size_t size) {
+    ++allocated;
+
+    void* p = std::malloc(size == 0u ? 1u : size);
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    return p;
+  }
+
+  void*
+  allocate(std::size_t size, std::align_val_t alignment) {
+    ++allocated;
+
+    // The size of `aligned_alloc` should be a multiple
+    // of the alignment.
+    const auto a = static_cast<std::size_t>(alignment);
+    void* p = std::aligned_alloc(a, (size + a - 1u) / a * a);
+    if (p == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    return p;
+  }
+# endif
+
+}
+
+namespace pge {
+  namespace allocations {
+
+    std::uint64_t
+    count() noexcept {
+      return allocated;
+    }
+
+  }
+}
+
+# if defined(PGE_COUNT_ALLOCATIONS)
+
+// Replacements of the global allocation functions: the
+// others (arrays and `nothrow` versions) call these ones
+// in the standard library.
+void*
+operator new(std::size_t size) {
+  return allocate(size);
+}
+
+void*
+operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate(size, alignment);
+}
+
+void
+operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t /*size*/) noexcept {
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::align_val_t /*alignment*/) noexcept {
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  std::free(p);
+}
+
+# endif
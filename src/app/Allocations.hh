@@ -0,0 +1,34 @@
+#ifndef    ALLOCATIONS_HH
+# define   ALLOCATIONS_HH
+
+# include <cstdint>
+
+namespace pge {
+  namespace allocations {
+
+    /**
+     * @brief - Whether the allocations are counted. This requires to
+     *          build with `ENABLE_ALLOCATION_COUNTER` which replaces
+     *          the global `operator new` with a counting version.
+     * @return - `true` if `count` is meaningful.
+     */
+    constexpr
+    bool
+    counted() noexcept;
+
+    /**
+     * @brief - The number of allocations performed by the calling
+     *          thread since it started. Allocations of the other
+     *          threads (as the log sink) are not included.
+     * @return - the number of allocations or `0` when they are not
+     *           counted.
+     */
+    std::uint64_t
+    count() noexcept;
+
+  }
+}
+
+# include "Allocations.hxx"
+
+#endif    /* ALLOCATIONS_HH */
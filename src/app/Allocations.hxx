@@ -0,0 +1,22 @@
+#ifndef    ALLOCATIONS_HXX
+# define   ALLOCATIONS_HXX
+
+# include "Allocations.hh"
+
+namespace pge {
+  namespace allocations {
+
+    constexpr
+    bool
+    counted() noexcept {
+# if defined(PGE_COUNT_ALLOCATIONS)
+      return true;
+# else
+      return false;
+# endif
+    }
+
+  }
+}
+
+#endif    /* ALLOCATIONS_HXX */
@@ -2,6 +2,7 @@
 # define   APP_DESC_HH
 
 # include <string>
+# include <cstddef>
 # include "olcEngine.hh"
 # include "Frame.hh"
 
@@ -30,6 +31,27 @@ namespace pge {
     // Whether or not the coordinate frame is fixed (meaning
     // that panning and zooming is disabled) or not.
     bool fixedFrame;
+
+    // Whether the app should be rendered in memory by the
+    // software renderer rather than in a window. This does
+    // not require any display nor GPU.
+    bool headless;
+
+    // The number of frames to run before stopping the app.
+    // A value of `0` means that the app runs until it is
+    // exited by the user.
+    unsigned frames;
+
+    // The duration in seconds of each frame as seen by the
+    // app. When it is positive it replaces the actual time
+    // elapsed so that runs are reproducible. Otherwise the
+    // real time is used.
+    float timestep;
+
+    // The number of bytes of textures decoded in the background
+    // which can be sent to the renderer in a single frame. At
+    // least one texture is sent in each frame.
+    std::size_t uploadBudget;
   };
 
   /**
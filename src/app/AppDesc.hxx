@@ -22,6 +22,12 @@ namespace pge {
 
     ad.fixedFrame = false;
 
+    ad.headless = false;
+    ad.frames = 0u;
+    ad.timestep = 0.0f;
+
+    ad.uploadBudget = 4u * 1024u * 1024u;
+
     return ad;
   }
 
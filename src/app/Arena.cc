@@ -0,0 +1,64 @@
+
+# include "Arena.hh"
+# include <cstdint>
+# include <algorithm>
+
+namespace pge {
+
+  Arena::Arena(std::size_t blockSize):
+    m_blockSize(blockSize),
+
+    m_blocks(),
+
+    m_current(0u),
+    m_offset(0u),
+
+    m_used(0u)
+  {}
+
+  void*
+  Arena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // Look for the first block with enough space: the
+    // blocks after the current one are free, they are
+    // left by a previous frame.
+    while (m_current < m_blocks.size()) {
+      const Block& b = m_blocks[m_current];
+
+      const auto base = reinterpret_cast<std::uintptr_t>(b.data.get());
+      const std::size_t start = ((base + m_offset + alignment - 1u) & ~(alignment - 1u)) - base;
+
+      if (start + bytes <= b.size) {
+        m_used += start + bytes - m_offset;
+        m_offset = start + bytes;
+        return b.data.get() + start;
+      }
+
+      ++m_current;
+      m_offset = 0u;
+    }
+
+    // Large allocations get a block of their own.
+    const std::size_t size = std::max(m_blockSize, bytes + alignment);
+    m_blocks.push_back(Block{std::make_unique<std::byte[]>(size), size});
+
+    return do_allocate(bytes, alignment);
+  }
+
+  void
+  Arena::reset() noexcept {
+    m_current = 0u;
+    m_offset = 0u;
+    m_used = 0u;
+  }
+
+  std::size_t
+  Arena::capacity() const noexcept {
+    std::size_t size = 0u;
+    for (const auto& b : m_blocks) {
+      size += b.size;
+    }
+
+    return size;
+  }
+
+}
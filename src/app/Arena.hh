@@ -0,0 +1,112 @@
+#ifndef    ARENA_HH
+# define   ARENA_HH
+
+# include <memory>
+# include <vector>
+# include <cstddef>
+# include <memory_resource>
+
+namespace pge {
+
+  /// @brief - A linear allocator for the data living during a single
+  /// frame. Allocating only bumps a pointer in the current block and
+  /// nothing is freed individually: all the memory is reclaimed at
+  /// once by `reset`. The blocks are kept across frames so that once
+  /// the arena reached the size needed by a frame, it does not need
+  /// to allocate anymore.
+  /// The arena is a memory resource: containers use it through the
+  /// `std::pmr` allocators, which lets code outside of the app (as
+  /// the coordinates) draw from it without depending on this class.
+  class Arena: public std::pmr::memory_resource {
+    public:
+
+      /**
+       * @brief - The default size of the blocks of the arena.
+       */
+      static constexpr std::size_t BlockSize = 64u * 1024u;
+
+      /**
+       * @brief - Create a new empty arena.
+       * @param blockSize - the size of the blocks to allocate.
+       */
+      Arena(std::size_t blockSize = BlockSize);
+
+      Arena(const Arena&) = delete;
+
+      Arena&
+      operator=(const Arena&) = delete;
+
+      /**
+       * @brief - Release all the memory reserved so far. The objects
+       *          built in the arena are not destroyed: they should be
+       *          destroyed before or be trivially destructible.
+       */
+      void
+      reset() noexcept;
+
+      /**
+       * @brief - The number of bytes reserved since the last reset.
+       * @return - the used size of the arena.
+       */
+      std::size_t
+      used() const noexcept;
+
+      /**
+       * @brief - The size of all the blocks of the arena.
+       * @return - the capacity of the arena.
+       */
+      std::size_t
+      capacity() const noexcept;
+
+    protected:
+
+      /**
+       * @brief - Reserve memory in the arena. A new block is created
+       *          when the current one is full.
+       * @param bytes - the size of the memory to reserve.
+       * @param alignment - the alignment of the memory to reserve.
+       * @return - a pointer to the memory, valid until the next call
+       *           to `reset`.
+       */
+      void*
+      do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+      /**
+       * @brief - Does nothing: the memory is released by `reset`.
+       */
+      void
+      do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+
+      /**
+       * @brief - Arenas do not share their memory: an arena is only
+       *          equal to itself.
+       */
+      bool
+      do_is_equal(const std::pmr::memory_resource& rhs) const noexcept override;
+
+    private:
+
+      struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+      };
+
+      std::size_t m_blockSize;
+
+      std::vector<Block> m_blocks;
+
+      /**
+       * @brief - The index of the block used by the allocations and
+       *          the position of the next allocation in it.
+       */
+      unsigned m_current;
+      std::size_t m_offset;
+
+      std::size_t m_used;
+  };
+
+}
+
+# include "Arena.hxx"
+
+#endif    /* ARENA_HH */
@@ -0,0 +1,26 @@
+#ifndef    ARENA_HXX
+# define   ARENA_HXX
+
+# include "Arena.hh"
+
+namespace pge {
+
+  inline
+  std::size_t
+  Arena::used() const noexcept {
+    return m_used;
+  }
+
+  inline
+  void
+  Arena::do_deallocate(void* /*p*/, std::size_t /*bytes*/, std::size_t /*alignment*/) {}
+
+  inline
+  bool
+  Arena::do_is_equal(const std::pmr::memory_resource& rhs) const noexcept {
+    return this == &rhs;
+  }
+
+}
+
+#endif    /* ARENA_HXX */
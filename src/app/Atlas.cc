@@ -0,0 +1,204 @@
+
+# include "Atlas.hh"
+# include <limits>
+# include <algorithm>
+# include "Trace.hh"
+
+namespace pge {
+
+  Atlas::Atlas(const olc::vi2d& pageSize,
+               int padding):
+    utils::CoreObject("atlas"),
+
+    m_pageSize(pageSize),
+    m_padding(std::max(padding, 0)),
+
+    m_pages(),
+    m_regions()
+  {
+    setService("textures");
+  }
+
+  Atlas::~Atlas() {
+    for (unsigned id = 0u ; id < m_pages.size() ; ++id) {
+      delete m_pages[id].res;
+      delete m_pages[id].data;
+    }
+
+    m_pages.clear();
+  }
+
+  atlas::Handle
+  Atlas::add(const olc::Sprite& image) {
+    trace::Scope scope("Atlas::add");
+
+    const olc::vi2d size(image.width, image.height);
+    const olc::vi2d padded = size + olc::vi2d(m_padding, m_padding);
+
+    // Pages are tried in the order they were created: the
+    // images too large for a regular page get a page with
+    // their own size.
+    olc::vi2d pos;
+    unsigned page = 0u;
+    while (page < m_pages.size() && !place(m_pages[page], padded, pos)) {
+      ++page;
+    }
+
+    if (page == m_pages.size()) {
+      page = createPage(olc::vi2d(
+        std::max(m_pageSize.x, padded.x),
+        std::max(m_pageSize.y, padded.y)
+      ));
+
+      if (!place(m_pages[page], padded, pos)) {
+        error(
+          "Failed to add image to atlas",
+          "Image with size " + std::to_string(size.x) + "x" + std::to_string(size.y) + " does not fit in an empty page"
+        );
+      }
+    }
+
+    Page& p = m_pages[page];
+
+    for (int y = 0 ; y < size.y ; ++y) {
+      const olc::Pixel* src = image.pColData + y * size.x;
+      std::copy(src, src + size.x, p.data->pColData + (pos.y + y) * p.data->width + pos.x);
+    }
+
+    p.dirty = true;
+
+    const olc::vf2d dims(p.data->width, p.data->height);
+
+    atlas::Region r;
+    r.res = p.res;
+    r.pos = pos;
+    r.size = size;
+    r.uvTL = olc::vf2d(pos) / dims;
+    r.uvBR = olc::vf2d(pos + size) / dims;
+
+    atlas::Handle handle = m_regions.size();
+    m_regions.push_back(r);
+
+    return handle;
+  }
+
+  atlas::Handle
+  Atlas::load(const std::string& file) {
+    olc::Sprite image(file);
+    if (image.pColData == nullptr || image.width <= 0 || image.height <= 0) {
+      error(
+        "Failed to load image \"" + file + "\"",
+        "Loading returned an empty image"
+      );
+    }
+
+    return add(image);
+  }
+
+  void
+  Atlas::upload() {
+    trace::Scope scope("Atlas::upload");
+
+    for (unsigned id = 0u ; id < m_pages.size() ; ++id) {
+      if (m_pages[id].dirty) {
+        m_pages[id].res->Update();
+        m_pages[id].dirty = false;
+      }
+    }
+  }
+
+  unsigned
+  Atlas::createPage(const olc::vi2d& size) {
+    Page p;
+
+    // The unused parts of the page are transparent.
+    p.data = new olc::Sprite(size.x, size.y);
+    std::fill(p.data->pColData, p.data->pColData + size.x * size.y, olc::BLANK);
+
+    p.res = new olc::Decal(p.data);
+
+    p.skyline.push_back(Segment{0, 0, size.x});
+    p.dirty = false;
+
+    unsigned id = m_pages.size();
+    m_pages.push_back(p);
+
+    return id;
+  }
+
+  bool
+  Atlas::place(Page& page,
+               const olc::vi2d& size,
+               olc::vi2d& pos) const
+  {
+    std::vector<Segment>& sky = page.skyline;
+
+    // Each segment is tried as the left edge of the area:
+    // the area lies on the highest segment it covers.
+    unsigned best = sky.size();
+    int bestY = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+
+    for (unsigned id = 0u ; id < sky.size() ; ++id) {
+      if (sky[id].x + size.x > page.data->width) {
+        break;
+      }
+
+      int y = 0;
+      int remaining = size.x;
+      for (unsigned s = id ; remaining > 0 ; ++s) {
+        y = std::max(y, sky[s].y);
+        remaining -= sky[s].width;
+      }
+
+      if (y + size.y > page.data->height) {
+        continue;
+      }
+
+      if (y < bestY || (y == bestY && sky[id].width < bestWidth)) {
+        best = id;
+        bestY = y;
+        bestWidth = sky[id].width;
+      }
+    }
+
+    if (best == sky.size()) {
+      return false;
+    }
+
+    pos = olc::vi2d(sky[best].x, bestY);
+
+    // Raise the skyline over the area and shorten the
+    // segments which are now partially covered.
+    sky.insert(sky.begin() + best, Segment{pos.x, pos.y + size.y, size.x});
+
+    const int end = pos.x + size.x;
+    unsigned id = best + 1u;
+    while (id < sky.size() && sky[id].x < end) {
+      const int covered = std::min(end - sky[id].x, sky[id].width);
+      sky[id].x += covered;
+      sky[id].width -= covered;
+
+      if (sky[id].width > 0) {
+        break;
+      }
+
+      sky.erase(sky.begin() + id);
+    }
+
+    // Merge the neighbours at the same height.
+    id = 0u;
+    while (id + 1u < sky.size()) {
+      if (sky[id].y == sky[id + 1u].y) {
+        sky[id].width += sky[id + 1u].width;
+        sky.erase(sky.begin() + id + 1u);
+      }
+      else {
+        ++id;
+      }
+    }
+
+    return true;
+  }
+
+}
@@ -0,0 +1,185 @@
+#ifndef    ATLAS_HH
+# define   ATLAS_HH
+
+# include <vector>
+# include <string>
+# include <core_utils/CoreObject.hh>
+# include "olcEngine.hh"
+
+namespace pge {
+  namespace atlas {
+
+    /// @brief - An identifier for an image added to an atlas. It stays
+    /// valid as long as the atlas exists.
+    using Handle = unsigned;
+
+    /// @brief - Describe where an image is stored in the atlas. Both
+    /// the pixels and the texture coordinates are precomputed so that
+    /// drawing the image does not need to look anything up.
+    struct Region {
+      // The `res` defines the page holding the image. It is
+      // shared by all the images packed in the same page.
+      olc::Decal* res;
+
+      // The `pos` defines the position in pixels of the top
+      // left corner of the image in the page.
+      olc::vi2d pos;
+
+      // The `size` defines the dimensions in pixels of the
+      // image.
+      olc::vi2d size;
+
+      // The `uvTL` and `uvBR` define the texture coordinates
+      // of the top left and bottom right corners of the image
+      // in the page.
+      olc::vf2d uvTL;
+      olc::vf2d uvBR;
+    };
+
+  }
+
+  class Atlas: public utils::CoreObject {
+    public:
+
+      /**
+       * @brief - Create a new atlas without any page.
+       * @param pageSize - the dimensions of the pages created to hold
+       *                   the images. Images larger than this get a
+       *                   page of their own.
+       * @param padding - the number of transparent pixels left between
+       *                  two images, to prevent filtering from picking
+       *                  texels of the neighbours.
+       */
+      Atlas(const olc::vi2d& pageSize = olc::vi2d(1024, 1024),
+            int padding = 1);
+
+      /**
+       * @brief - Release the pages of the atlas: the regions of the
+       *          images are not valid anymore.
+       */
+      ~Atlas();
+
+      Atlas(const Atlas&) = delete;
+
+      Atlas&
+      operator=(const Atlas&) = delete;
+
+      /**
+       * @brief - Copy the input image in the atlas. It is placed in
+       *          the first page with enough room, or in a new page.
+       *          The pages are only sent to the renderer by `upload`.
+       * @param image - the image to copy.
+       * @return - the handle to the image.
+       */
+      atlas::Handle
+      add(const olc::Sprite& image);
+
+      /**
+       * @brief - Load the image from the input file and add it to the
+       *          atlas. Raises an error if the file cannot be loaded.
+       * @param file - the path to the image to load.
+       * @return - the handle to the image.
+       */
+      atlas::Handle
+      load(const std::string& file);
+
+      /**
+       * @brief - Send the pages modified since the last call to the
+       *          renderer. This should be called once after adding a
+       *          group of images and before drawing them.
+       */
+      void
+      upload();
+
+      /**
+       * @brief - Return the region of the atlas storing an image. An
+       *          error is raised if the handle is not valid.
+       * @param handle - the handle of the image.
+       * @return - the region of the image.
+       */
+      const atlas::Region&
+      region(atlas::Handle handle) const;
+
+      /**
+       * @brief - The number of pages created so far.
+       * @return - the number of pages.
+       */
+      unsigned
+      pages() const noexcept;
+
+      /**
+       * @brief - The number of images stored in the atlas.
+       * @return - the number of images.
+       */
+      unsigned
+      size() const noexcept;
+
+    private:
+
+      /// @brief - A horizontal segment of the skyline of a page: the
+      /// area below it is already used.
+      struct Segment {
+        int x;
+        int y;
+        int width;
+      };
+
+      /// @brief - A texture holding several images. The skyline is
+      /// the upper limit of the used area, from left to right.
+      struct Page {
+        olc::Sprite* data;
+        olc::Decal* res;
+
+        std::vector<Segment> skyline;
+
+        bool dirty;
+      };
+
+      /**
+       * @brief - Create a new empty page.
+       * @param size - the dimensions of the page.
+       * @return - the index of the page.
+       */
+      unsigned
+      createPage(const olc::vi2d& size);
+
+      /**
+       * @brief - Find a place for a rectangle in the page using the
+       *          bottom-left rule: the rectangle is put as high as
+       *          possible, then as far left as possible. The skyline
+       *          is updated if the rectangle fits.
+       * @param page - the page to place the rectangle in.
+       * @param size - the dimensions of the rectangle.
+       * @param pos - output position of the rectangle.
+       * @return - `true` if the rectangle fits in the page.
+       */
+      bool
+      place(Page& page,
+            const olc::vi2d& size,
+            olc::vi2d& pos) const;
+
+    private:
+
+      /**
+       * @brief - The dimensions of the regular pages.
+       */
+      olc::vi2d m_pageSize;
+
+      /**
+       * @brief - The space left between images.
+       */
+      int m_padding;
+
+      std::vector<Page> m_pages;
+
+      /**
+       * @brief - The regions of the images, indexed by their handle.
+       */
+      std::vector<atlas::Region> m_regions;
+  };
+
+}
+
+# include "Atlas.hxx"
+
+#endif    /* ATLAS_HH */
@@ -0,0 +1,35 @@
+#ifndef    ATLAS_HXX
+# define   ATLAS_HXX
+
+# include "Atlas.hh"
+
+namespace pge {
+
+  inline
+  const atlas::Region&
+  Atlas::region(atlas::Handle handle) const {
+    if (handle >= m_regions.size()) {
+      error(
+        "Unable to find region of image " + std::to_string(handle),
+        "Only " + std::to_string(m_regions.size()) + " image(s) available"
+      );
+    }
+
+    return m_regions[handle];
+  }
+
+  inline
+  unsigned
+  Atlas::pages() const noexcept {
+    return m_pages.size();
+  }
+
+  inline
+  unsigned
+  Atlas::size() const noexcept {
+    return m_regions.size();
+  }
+
+}
+
+#endif    /* ATLAS_HXX */
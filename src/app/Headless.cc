@@ -0,0 +1,389 @@
+
+# include "Headless.hh"
+# include <array>
+# include <cmath>
+# include <cstdio>
+# include <algorithm>
+# include <png.h>
+
+namespace {
+
+  float
+  edge(const olc::vf2d& a, const olc::vf2d& b, const olc::vf2d& p) noexcept {
+    return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+  }
+
+  /// @brief - Whether pixels lying exactly on the edge going from `a` to
+  /// `b` belong to the triangle. The rule only depends on the direction
+  /// of the edge: an edge shared by two triangles is traversed in both
+  /// directions so its pixels are drawn exactly once.
+  bool
+  owns(const olc::vf2d& a, const olc::vf2d& b) noexcept {
+    const olc::vf2d d = b - a;
+    return d.y < 0.0f || (d.y == 0.0f && d.x > 0.0f);
+  }
+
+  olc::Pixel
+  tinted(const olc::Pixel& c, const olc::Pixel& tint) noexcept {
+    return olc::Pixel(
+      static_cast<uint8_t>((c.r * tint.r + 127u) / 255u),
+      static_cast<uint8_t>((c.g * tint.g + 127u) / 255u),
+      static_cast<uint8_t>((c.b * tint.b + 127u) / 255u),
+      static_cast<uint8_t>((c.a * tint.a + 127u) / 255u)
+    );
+  }
+
+  template <typename Texture>
+  olc::Pixel
+  sample(const Texture& tex, float u, float v) noexcept {
+    // Nearest sampling with clamping to the borders.
+    const int x = std::clamp(static_cast<int>(std::floor(u * tex.width)), 0, tex.width - 1);
+    const int y = std::clamp(static_cast<int>(std::floor(v * tex.height)), 0, tex.height - 1);
+
+    return tex.pixels[y * tex.width + x];
+  }
+
+}
+
+namespace pge::headless {
+
+  Renderer::Renderer():
+    olc::Renderer(),
+
+    m_dims(),
+    m_back(),
+    m_front(),
+
+    m_textures(),
+    m_nextTexture(1u),
+    m_applied(0u),
+
+    m_frames(0u)
+  {}
+
+  void
+  Renderer::PrepareDevice() {}
+
+  olc::rcode
+  Renderer::CreateDevice(std::vector<void*> /*params*/, bool /*bFullScreen*/, bool /*bVSYNC*/) {
+    resize();
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Renderer::DestroyDevice() {
+    m_textures.clear();
+    return olc::rcode::OK;
+  }
+
+  void
+  Renderer::DisplayFrame() {
+    // The back buffer is cleared before each frame
+    // so its content does not need to be kept.
+    std::swap(m_front, m_back);
+    ++m_frames;
+  }
+
+  void
+  Renderer::PrepareDrawing() {
+    resize();
+  }
+
+  void
+  Renderer::DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) {
+    const auto it = m_textures.find(m_applied);
+    if (it == m_textures.cend() || it->second.pixels.empty()) {
+      return;
+    }
+
+    const Texture& tex = it->second;
+
+    for (int y = 0 ; y < m_dims.y ; ++y) {
+      const float v = (y + 0.5f) / m_dims.y * scale.y + offset.y;
+
+      for (int x = 0 ; x < m_dims.x ; ++x) {
+        const float u = (x + 0.5f) / m_dims.x * scale.x + offset.x;
+
+        const olc::Pixel c = tinted(sample(tex, u, v), tint);
+        if (c.a > 0u) {
+          blend(y * m_dims.x + x, c);
+        }
+      }
+    }
+  }
+
+  void
+  Renderer::DrawDecalQuad(const olc::DecalInstance& decal) {
+    const Texture* tex = nullptr;
+    if (decal.decal != nullptr) {
+      const auto it = m_textures.find(static_cast<uint32_t>(decal.decal->id));
+      if (it == m_textures.cend() || it->second.pixels.empty()) {
+        return;
+      }
+
+      tex = &it->second;
+    }
+
+    // Positions are expressed in normalized device
+    // coordinates. Textured decals are tinted with
+    // a single color, the first one.
+    std::array<Vertex, 4> v;
+    for (unsigned id = 0u ; id < v.size() ; ++id) {
+      v[id].p = olc::vf2d(
+        (decal.pos[id].x + 1.0f) * 0.5f * m_dims.x,
+        (1.0f - decal.pos[id].y) * 0.5f * m_dims.y
+      );
+      v[id].uv = decal.uv[id];
+      v[id].w = decal.w[id];
+      v[id].tint = (tex == nullptr ? decal.tint[id] : decal.tint[0]);
+    }
+
+    drawTriangle(v[0], v[1], v[2], tex);
+    drawTriangle(v[0], v[2], v[3], tex);
+  }
+
+  uint32_t
+  Renderer::CreateTexture(const uint32_t width, const uint32_t height) {
+    const uint32_t id = m_nextTexture++;
+
+    Texture& tex = m_textures[id];
+    tex.width = width;
+    tex.height = height;
+
+    return id;
+  }
+
+  void
+  Renderer::UpdateTexture(uint32_t id, olc::Sprite* spr) {
+    if (spr == nullptr) {
+      return;
+    }
+
+    // Textures keep a copy of the sprite, as the
+    // upload to a GPU would.
+    Texture& tex = m_textures[id];
+    tex.width = spr->width;
+    tex.height = spr->height;
+
+    const olc::Pixel* data = spr->GetData();
+    tex.pixels.assign(data, data + tex.width * tex.height);
+  }
+
+  uint32_t
+  Renderer::DeleteTexture(const uint32_t id) {
+    m_textures.erase(id);
+    return id;
+  }
+
+  void
+  Renderer::ApplyTexture(uint32_t id) {
+    m_applied = id;
+  }
+
+  void
+  Renderer::UpdateViewport(const olc::vi2d& /*pos*/, const olc::vi2d& /*size*/) {
+    // The buffer always has the size of the screen
+    // and not the one of the window.
+    resize();
+  }
+
+  void
+  Renderer::ClearBuffer(olc::Pixel p, bool /*bDepth*/) {
+    resize();
+    std::fill(m_back.begin(), m_back.end(), p);
+  }
+
+  void
+  Renderer::resize() {
+    const olc::vi2d dims(ptrPGE->ScreenWidth(), ptrPGE->ScreenHeight());
+    if (dims == m_dims) {
+      return;
+    }
+
+    m_dims = dims;
+    m_back.assign(m_dims.x * m_dims.y, olc::BLACK);
+    m_front.assign(m_dims.x * m_dims.y, olc::BLACK);
+  }
+
+  void
+  Renderer::drawTriangle(const Vertex& v0,
+                         const Vertex& v1,
+                         const Vertex& v2,
+                         const Texture* tex)
+  {
+    const float area = edge(v0.p, v1.p, v2.p);
+    if (area == 0.0f) {
+      return;
+    }
+
+    // Orient the triangle so that the edge functions
+    // are positive inside of it.
+    const Vertex& a = v0;
+    const Vertex& b = (area > 0.0f ? v1 : v2);
+    const Vertex& c = (area > 0.0f ? v2 : v1);
+    const float inv = 1.0f / std::abs(area);
+
+    const int xMin = std::max(0, static_cast<int>(std::floor(std::min({a.p.x, b.p.x, c.p.x}))));
+    const int xMax = std::min(m_dims.x - 1, static_cast<int>(std::ceil(std::max({a.p.x, b.p.x, c.p.x}))));
+    const int yMin = std::max(0, static_cast<int>(std::floor(std::min({a.p.y, b.p.y, c.p.y}))));
+    const int yMax = std::min(m_dims.y - 1, static_cast<int>(std::ceil(std::max({a.p.y, b.p.y, c.p.y}))));
+
+    const bool ownsA = owns(b.p, c.p);
+    const bool ownsB = owns(c.p, a.p);
+    const bool ownsC = owns(a.p, b.p);
+
+    for (int y = yMin ; y <= yMax ; ++y) {
+      for (int x = xMin ; x <= xMax ; ++x) {
+        const olc::vf2d p(x + 0.5f, y + 0.5f);
+
+        const float wa = edge(b.p, c.p, p);
+        const float wb = edge(c.p, a.p, p);
+        const float wc = edge(a.p, b.p, p);
+
+        if (wa < 0.0f || wb < 0.0f || wc < 0.0f) {
+          continue;
+        }
+        if ((wa == 0.0f && !ownsA) || (wb == 0.0f && !ownsB) || (wc == 0.0f && !ownsC)) {
+          continue;
+        }
+
+        const float la = wa * inv;
+        const float lb = wb * inv;
+        const float lc = wc * inv;
+
+        const auto lerp = [la, lb, lc](float fa, float fb, float fc) {
+          return la * fa + lb * fb + lc * fc;
+        };
+
+        const olc::Pixel tint(
+          static_cast<uint8_t>(lerp(a.tint.r, b.tint.r, c.tint.r) + 0.5f),
+          static_cast<uint8_t>(lerp(a.tint.g, b.tint.g, c.tint.g) + 0.5f),
+          static_cast<uint8_t>(lerp(a.tint.b, b.tint.b, c.tint.b) + 0.5f),
+          static_cast<uint8_t>(lerp(a.tint.a, b.tint.a, c.tint.a) + 0.5f)
+        );
+
+        olc::Pixel col = tint;
+        if (tex != nullptr) {
+          // Texture coordinates are projective (see the
+          // `DrawWarpedDecal` method).
+          const float w = lerp(a.w, b.w, c.w);
+          const float u = lerp(a.uv.x, b.uv.x, c.uv.x) / w;
+          const float v = lerp(a.uv.y, b.uv.y, c.uv.y) / w;
+
+          col = tinted(sample(*tex, u, v), tint);
+        }
+
+        if (col.a > 0u) {
+          blend(y * m_dims.x + x, col);
+        }
+      }
+    }
+  }
+
+  bool
+  writePng(const std::string& file,
+           const olc::Pixel* pixels,
+           const olc::vi2d& dims)
+  {
+    FILE* out = std::fopen(file.c_str(), "wb");
+    if (out == nullptr) {
+      return false;
+    }
+
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = (png == nullptr ? nullptr : png_create_info_struct(png));
+    if (info == nullptr || setjmp(png_jmpbuf(png))) {
+      png_destroy_write_struct(&png, &info);
+      std::fclose(out);
+      return false;
+    }
+
+    png_init_io(png, out);
+    png_set_IHDR(
+      png,
+      info,
+      dims.x,
+      dims.y,
+      8,
+      PNG_COLOR_TYPE_RGBA,
+      PNG_INTERLACE_NONE,
+      PNG_COMPRESSION_TYPE_DEFAULT,
+      PNG_FILTER_TYPE_DEFAULT
+    );
+    png_write_info(png, info);
+
+    // Pixels are stored as `RGBA` bytes.
+    for (int y = 0 ; y < dims.y ; ++y) {
+      png_write_row(png, reinterpret_cast<png_const_bytep>(pixels + y * dims.x));
+    }
+
+    png_write_end(png, nullptr);
+    png_destroy_write_struct(&png, &info);
+    std::fclose(out);
+
+    return true;
+  }
+
+  Platform::Platform(Renderer& renderer):
+    olc::Platform(),
+
+    m_renderer(renderer)
+  {}
+
+  olc::rcode
+  Platform::ApplicationStartUp() {
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::ApplicationCleanUp() {
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::ThreadStartUp() {
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::ThreadCleanUp() {
+    m_renderer.DestroyDevice();
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::CreateGraphics(bool bFullScreen, bool bEnableVSYNC, const olc::vi2d& vViewPos, const olc::vi2d& vViewSize) {
+    if (m_renderer.CreateDevice({}, bFullScreen, bEnableVSYNC) != olc::rcode::OK) {
+      return olc::rcode::FAIL;
+    }
+
+    m_renderer.UpdateViewport(vViewPos, vViewSize);
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::CreateWindowPane(const olc::vi2d& /*vWindowPos*/, olc::vi2d& /*vWindowSize*/, bool /*bFullScreen*/) {
+    // There is no window: consider that it always
+    // has the focus.
+    ptrPGE->olc_UpdateKeyFocus(true);
+    ptrPGE->olc_UpdateMouseFocus(true);
+
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::SetWindowTitle(const std::string& /*s*/) {
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::StartSystemEventLoop() {
+    return olc::rcode::OK;
+  }
+
+  olc::rcode
+  Platform::HandleSystemEvent() {
+    return olc::rcode::OK;
+  }
+
+}
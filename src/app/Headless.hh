@@ -0,0 +1,227 @@
+#ifndef    HEADLESS_HH
+# define   HEADLESS_HH
+
+# include <string>
+# include <vector>
+# include <cstdint>
+# include <unordered_map>
+# include "olcEngine.hh"
+
+namespace pge::headless {
+
+  /// @brief - A software implementation of the renderer of the pixel
+  /// game engine. Layers and decals are composited on the CPU into an
+  /// in-memory RGBA buffer with the same conventions as the OpenGL
+  /// renderer (modulated tints, alpha blending, nearest sampling). It
+  /// does not need any display nor GPU.
+  class Renderer: public olc::Renderer {
+    public:
+
+      Renderer();
+
+      void
+      PrepareDevice() override;
+
+      olc::rcode
+      CreateDevice(std::vector<void*> params, bool bFullScreen, bool bVSYNC) override;
+
+      olc::rcode
+      DestroyDevice() override;
+
+      void
+      DisplayFrame() override;
+
+      void
+      PrepareDrawing() override;
+
+      void
+      DrawLayerQuad(const olc::vf2d& offset, const olc::vf2d& scale, const olc::Pixel tint) override;
+
+      void
+      DrawDecalQuad(const olc::DecalInstance& decal) override;
+
+      uint32_t
+      CreateTexture(const uint32_t width, const uint32_t height) override;
+
+      void
+      UpdateTexture(uint32_t id, olc::Sprite* spr) override;
+
+      uint32_t
+      DeleteTexture(const uint32_t id) override;
+
+      void
+      ApplyTexture(uint32_t id) override;
+
+      void
+      UpdateViewport(const olc::vi2d& pos, const olc::vi2d& size) override;
+
+      void
+      ClearBuffer(olc::Pixel p, bool bDepth) override;
+
+      /**
+       * @brief - The dimensions of the buffer in pixels. It matches the
+       *          size of the screen of the engine.
+       * @return - the dimensions of the buffer.
+       */
+      olc::vi2d
+      dims() const noexcept;
+
+      /**
+       * @brief - The content of the last frame displayed, stored row by
+       *          row from the top left corner.
+       * @return - the pixels of the last frame.
+       */
+      const std::vector<olc::Pixel>&
+      frame() const noexcept;
+
+      /**
+       * @brief - The number of frames displayed so far.
+       * @return - the number of frames.
+       */
+      unsigned
+      frames() const noexcept;
+
+    private:
+
+      /// @brief - The copy of the content of a sprite.
+      struct Texture {
+        int width;
+        int height;
+        std::vector<olc::Pixel> pixels;
+      };
+
+      /// @brief - The attributes of a vertex interpolated over a triangle.
+      struct Vertex {
+        olc::vf2d p;
+        olc::vf2d uv;
+        float w;
+        olc::Pixel tint;
+      };
+
+      /**
+       * @brief - Make sure the buffers have the size of the screen.
+       */
+      void
+      resize();
+
+      /**
+       * @brief - Rasterize a triangle in the working buffer, sampling
+       *          the input texture (if any) and blending the result.
+       * @param v0 - the first vertex.
+       * @param v1 - the second vertex.
+       * @param v2 - the third vertex.
+       * @param tex - the texture to sample or `nullptr`.
+       */
+      void
+      drawTriangle(const Vertex& v0,
+                   const Vertex& v1,
+                   const Vertex& v2,
+                   const Texture* tex);
+
+      /**
+       * @brief - Blend the input color into the pixel of the working
+       *          buffer at the specified index.
+       * @param id - the index of the pixel.
+       * @param c - the color to blend.
+       */
+      void
+      blend(unsigned id, const olc::Pixel& c) noexcept;
+
+    private:
+
+      /// @brief - The dimensions of the buffers.
+      olc::vi2d m_dims;
+
+      /// @brief - The buffer where the current frame is composited.
+      std::vector<olc::Pixel> m_back;
+
+      /// @brief - The last frame displayed.
+      std::vector<olc::Pixel> m_front;
+
+      /// @brief - The textures indexed by their identifier, and the next
+      /// identifier to assign.
+      std::unordered_map<uint32_t, Texture> m_textures;
+      uint32_t m_nextTexture;
+
+      /// @brief - The texture applied to the layers.
+      uint32_t m_applied;
+
+      /// @brief - The number of frames displayed.
+      unsigned m_frames;
+  };
+
+  /// @brief - A platform without any window nor input: the engine runs
+  /// as long as the application does not request to stop it.
+  class Platform: public olc::Platform {
+    public:
+
+      /**
+       * @brief - Create a platform using the specified renderer.
+       * @param renderer - the renderer to create the graphics with.
+       */
+      Platform(Renderer& renderer);
+
+      olc::rcode
+      ApplicationStartUp() override;
+
+      olc::rcode
+      ApplicationCleanUp() override;
+
+      olc::rcode
+      ThreadStartUp() override;
+
+      olc::rcode
+      ThreadCleanUp() override;
+
+      olc::rcode
+      CreateGraphics(bool bFullScreen, bool bEnableVSYNC, const olc::vi2d& vViewPos, const olc::vi2d& vViewSize) override;
+
+      olc::rcode
+      CreateWindowPane(const olc::vi2d& vWindowPos, olc::vi2d& vWindowSize, bool bFullScreen) override;
+
+      olc::rcode
+      SetWindowTitle(const std::string& s) override;
+
+      olc::rcode
+      StartSystemEventLoop() override;
+
+      olc::rcode
+      HandleSystemEvent() override;
+
+    private:
+
+      /// @brief - The renderer used by the engine.
+      Renderer& m_renderer;
+  };
+
+  /**
+   * @brief - Save the input pixels as a PNG image. This is used to dump
+   *          the content of the rendering when no window is available.
+   * @param file - the path of the image to create.
+   * @param pixels - the pixels to save, stored row by row.
+   * @param dims - the dimensions of the image in pixels.
+   * @return - `true` if the image could be written.
+   */
+  bool
+  writePng(const std::string& file,
+           const olc::Pixel* pixels,
+           const olc::vi2d& dims);
+
+  /**
+   * @brief - Replace the renderer and the platform of the engine with
+   *          the headless ones. It should be called before the engine
+   *          is started.
+   *          Note that the engine keeps its systems in variables local
+   *          to the translation unit implementing it: this function is
+   *          thus defined along with the engine (see `olcEngine.cc`).
+   * @param pge - the engine to configure.
+   * @return - the renderer installed in the engine.
+   */
+  Renderer*
+  install(olc::PixelGameEngine& pge);
+
+}
+
+# include "Headless.hxx"
+
+#endif    /* HEADLESS_HH */
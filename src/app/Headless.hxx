@@ -0,0 +1,43 @@
+#ifndef    HEADLESS_HXX
+# define   HEADLESS_HXX
+
+# include "Headless.hh"
+
+namespace pge::headless {
+
+  inline
+  olc::vi2d
+  Renderer::dims() const noexcept {
+    return m_dims;
+  }
+
+  inline
+  const std::vector<olc::Pixel>&
+  Renderer::frame() const noexcept {
+    return m_front;
+  }
+
+  inline
+  unsigned
+  Renderer::frames() const noexcept {
+    return m_frames;
+  }
+
+  inline
+  void
+  Renderer::blend(unsigned id, const olc::Pixel& c) noexcept {
+    // Equivalent to `glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)`
+    // applied to all channels.
+    olc::Pixel& d = m_back[id];
+    const unsigned a = c.a;
+    const unsigned ia = 255u - a;
+
+    d.r = static_cast<uint8_t>((c.r * a + d.r * ia + 127u) / 255u);
+    d.g = static_cast<uint8_t>((c.g * a + d.g * ia + 127u) / 255u);
+    d.b = static_cast<uint8_t>((c.b * a + d.b * ia + 127u) / 255u);
+    d.a = static_cast<uint8_t>((c.a * a + d.a * ia + 127u) / 255u);
+  }
+
+}
+
+#endif    /* HEADLESS_HXX */
@@ -0,0 +1,134 @@
+
+# include "Log.hh"
+# include <mutex>
+# include <atomic>
+# include <thread>
+# include <vector>
+# include <condition_variable>
+# include <core_utils/PrefixedLogger.hh>
+
+namespace {
+
+  /// @brief - The messages waiting to be logged and the thread logging
+  /// them. Producers only append to the queue under the lock: the sink
+  /// swaps it with an empty one and formats the messages without it.
+  struct Sink {
+    std::mutex lock;
+    std::condition_variable wake;
+    std::vector<pge::log::details::Record> queue;
+
+    bool running = false;
+    std::thread worker;
+  };
+
+  Sink&
+  sink() {
+    static Sink s;
+    return s;
+  }
+
+  std::atomic<int> level(static_cast<int>(utils::Level::Verbose));
+
+  void
+  emit(const pge::log::details::Record& record) {
+    utils::PrefixedLogger logger(record.service(), record.module());
+    logger.logMessage(record.level(), record.format());
+  }
+
+  void
+  drain() {
+    Sink& s = sink();
+    std::vector<pge::log::details::Record> batch;
+
+    std::unique_lock guard(s.lock);
+    while (s.running || !s.queue.empty()) {
+      s.wake.wait(guard, [&s] { return !s.running || !s.queue.empty(); });
+
+      batch.swap(s.queue);
+      guard.unlock();
+
+      for (const auto& record : batch) {
+        emit(record);
+      }
+      batch.clear();
+
+      guard.lock();
+    }
+  }
+
+}
+
+namespace pge {
+  namespace log {
+
+    bool
+    enabled(const utils::Level& lvl) noexcept {
+      return static_cast<int>(lvl) >= level.load(std::memory_order_relaxed);
+    }
+
+    void
+    setLevel(const utils::Level& lvl) noexcept {
+      level.store(static_cast<int>(lvl), std::memory_order_relaxed);
+    }
+
+    void
+    start() {
+      Sink& s = sink();
+      const std::lock_guard guard(s.lock);
+
+      if (s.running) {
+        return;
+      }
+
+      s.running = true;
+      s.worker = std::thread(drain);
+    }
+
+    void
+    stop() {
+      Sink& s = sink();
+
+      {
+        const std::lock_guard guard(s.lock);
+        if (!s.running) {
+          return;
+        }
+
+        s.running = false;
+      }
+
+      // The worker logs the remaining messages before
+      // exiting.
+      s.wake.notify_one();
+      s.worker.join();
+    }
+
+    namespace details {
+
+      void
+      push(Record&& record) {
+        Sink& s = sink();
+
+        {
+          std::unique_lock guard(s.lock);
+          if (s.running) {
+            // The sink only waits when the queue is empty,
+            // so there is no need to wake it up otherwise.
+            const bool idle = s.queue.empty();
+            s.queue.push_back(std::move(record));
+            guard.unlock();
+
+            if (idle) {
+              s.wake.notify_one();
+            }
+            return;
+          }
+        }
+
+        emit(record);
+      }
+
+    }
+
+  }
+}
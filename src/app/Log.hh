@@ -0,0 +1,321 @@
+#ifndef    LOG_HH
+# define   LOG_HH
+
+# include <array>
+# include <string>
+# include <string_view>
+# include <cstddef>
+# include <utility>
+# include <type_traits>
+# include <core_utils/Level.hh>
+
+/// @brief - The minimum level of the messages compiled in the binary:
+/// the logging macros below this level expand to nothing, so neither
+/// their arguments nor the check of the level remain. The value is the
+/// index of the level in `utils::Level` (from `0` for `Verbose` up to
+/// `7` for `Fatal`) and can be set when configuring the build.
+# ifndef PGE_LOG_LEVEL
+#  define PGE_LOG_LEVEL 0
+# endif
+
+namespace pge {
+  namespace log {
+
+    /**
+     * @brief - Whether messages with the input level are compiled in.
+     * @param level - the level of the messages.
+     * @return - `true` if the messages are kept in the binary.
+     */
+    constexpr
+    bool
+    compiled(const utils::Level& level) noexcept;
+
+    /**
+     * @brief - Whether messages with the input level are currently
+     *          emitted. This is a single atomic load, so that filtered
+     *          messages are discarded before any formatting happens.
+     * @param level - the level of the messages.
+     * @return - `true` if the messages reach the logger.
+     */
+    bool
+    enabled(const utils::Level& level) noexcept;
+
+    /**
+     * @brief - Define the minimum level of the emitted messages. This
+     *          should match the level of the logger used by the app.
+     * @param level - the new minimum level.
+     */
+    void
+    setLevel(const utils::Level& level) noexcept;
+
+    /**
+     * @brief - Start the thread formatting the messages and forwarding
+     *          them to the logger. Until then, and after `stop`, the
+     *          messages are formatted and logged by the caller.
+     */
+    void
+    start();
+
+    /**
+     * @brief - Log all the pending messages and stop the thread which
+     *          formats them. Called before the logger is destroyed.
+     */
+    void
+    stop();
+
+    namespace details {
+
+      /// @brief - A string literal given to a message. Literals live as
+      /// long as the program so only a pointer to them is kept.
+      struct Literal {
+        const char* text;
+
+        operator std::string_view() const noexcept;
+      };
+
+      /**
+       * @brief - Prepare an argument of a message to be recorded. The
+       *          logging macros tell whether the argument is written
+       *          as a string literal in the code: only these are kept
+       *          by pointer, as nothing distinguishes them from other
+       *          arrays of characters in the type system.
+       * @param arg - the argument to prepare.
+       * @return - the literal or the argument itself.
+       */
+      template <bool IsLiteral, typename Arg>
+      constexpr
+      decltype(auto)
+      capture(Arg&& arg) noexcept;
+
+      /// @brief - Whether the type refers to characters which may not
+      /// outlive the call: arrays, pointers and views of characters.
+      template <typename Arg>
+      constexpr bool Text =
+        (std::is_array_v<std::remove_reference_t<Arg>> &&
+         std::is_same_v<std::remove_cv_t<std::remove_extent_t<std::remove_reference_t<Arg>>>, char>) ||
+        std::is_same_v<std::decay_t<Arg>, const char*> ||
+        std::is_same_v<std::decay_t<Arg>, char*> ||
+        std::is_same_v<std::decay_t<Arg>, std::string_view>;
+
+      /// @brief - The type under which an argument is kept in a record:
+      /// characters which are not a literal are copied in a string, the
+      /// other arguments are copied as is.
+      template <typename Arg>
+      using Stored = std::conditional_t<Text<Arg>, std::string, std::decay_t<Arg>>;
+
+      /// @brief - A message waiting to be formatted. Its arguments are
+      /// copied in the record so that the caller only pays for copying
+      /// them: the conversion to a string happens on the thread of the
+      /// sink. Arguments larger than the inline storage are allocated.
+      class Record {
+        public:
+
+          /**
+           * @brief - The size available to store the arguments without
+           *          allocating.
+           */
+          static constexpr std::size_t Storage = 128u;
+
+          /**
+           * @brief - Create a new record with the input arguments.
+           * @param level - the level of the message.
+           * @param service - the service of the element producing it.
+           * @param module - the name of the element producing it.
+           * @param args - the arguments of the message.
+           */
+          template <typename... Args>
+          Record(const utils::Level& level,
+                 const std::string& service,
+                 const std::string& module,
+                 Args&&... args);
+
+          Record(Record&& rhs) noexcept;
+
+          Record&
+          operator=(Record&& rhs) noexcept;
+
+          Record(const Record&) = delete;
+
+          Record&
+          operator=(const Record&) = delete;
+
+          ~Record();
+
+          /**
+           * @brief - The level of the message.
+           * @return - the level of the message.
+           */
+          const utils::Level&
+          level() const noexcept;
+
+          /**
+           * @brief - The service of the element which produced the
+           *          message.
+           * @return - the service of the element.
+           */
+          const std::string&
+          service() const noexcept;
+
+          /**
+           * @brief - The element which produced the message.
+           * @return - the name of the element.
+           */
+          const std::string&
+          module() const noexcept;
+
+          /**
+           * @brief - Convert the arguments to the text of the message.
+           * @return - the formatted message.
+           */
+          std::string
+          format() const;
+
+        private:
+
+          /**
+           * @brief - The operations performed on the stored arguments,
+           *          generated for each set of argument types.
+           */
+          struct Operations {
+            void (*format)(const void* args, std::string& out);
+            void (*move)(void* from, void* to) noexcept;
+            void (*destroy)(void* args) noexcept;
+          };
+
+          template <typename Pack>
+          static const Operations&
+          operations() noexcept;
+
+          /**
+           * @brief - Whether the arguments can be stored inline.
+           * @return - `true` if no allocation is needed.
+           */
+          template <typename Pack>
+          static constexpr
+          bool
+          fits() noexcept;
+
+          void*
+          arguments() noexcept;
+
+          const void*
+          arguments() const noexcept;
+
+          void
+          reset() noexcept;
+
+        private:
+
+          utils::Level m_level;
+          std::string m_service;
+          std::string m_module;
+
+          const Operations* m_ops;
+
+          /**
+           * @brief - Either the arguments themselves or, when they do
+           *          not fit, a pointer to their heap allocated copy.
+           */
+          alignas(std::max_align_t) std::array<std::byte, Storage> m_storage;
+      };
+
+      /**
+       * @brief - Queue the record to be logged by the sink, or log it
+       *          directly when no sink is running.
+       * @param record - the record to log.
+       */
+      void
+      push(Record&& record);
+
+    }
+
+    /**
+     * @brief - Append the textual representation of a value to the
+     *          output string. Strings and characters are copied as
+     *          is, arithmetic types use `std::to_string`, the vectors of `olc` are
+     *          written as `(x,y)` and other types use their `str`
+     *          method or `operator<<`.
+     * @param out - the string to append to.
+     * @param value - the value to convert.
+     */
+    template <typename T>
+    void
+    append(std::string& out, const T& value);
+
+    /**
+     * @brief - Queue a new message: the arguments are concatenated in
+     *          their textual representation once the message reaches
+     *          the sink. Messages filtered by the level are discarded
+     *          without copying the arguments.
+     * @param level - the level of the message.
+     * @param service - the service of the element producing the
+     *                  message.
+     * @param module - the name of the element producing the message.
+     * @param args - the parts of the message.
+     */
+    template <typename... Args>
+    void
+    push(const utils::Level& level,
+         const std::string& service,
+         const std::string& module,
+         Args&&... args);
+
+  }
+}
+
+/// @brief - Log a message with an explicit prefix, made of the service
+/// and the name of the element producing it: the arguments are only
+/// evaluated if the level is both compiled in and enabled, and are
+/// formatted asynchronously (see `pge::log::push`).
+# define PGE_LOG_AS(level, service, module, ...)                     \
+  do {                                                                \
+    if constexpr (::pge::log::compiled(level)) {                      \
+      if (::pge::log::enabled(level)) {                               \
+        ::pge::log::push(                                             \
+          level,                                                      \
+          service,                                                    \
+          module                                                      \
+          PGE_LOG_CAPTURE(__VA_ARGS__)                                \
+        );                                                            \
+      }                                                               \
+    }                                                                 \
+  } while (false)
+
+/// @brief - Log a message from a `utils::CoreObject`, with the same
+/// prefix as its own messages. The service given to `setService` can
+/// not be read back from the object: the class should also define it
+/// as a `LogService` constant.
+# define PGE_LOG(level, ...)                                         \
+  PGE_LOG_AS(level, LogService, getName(), __VA_ARGS__)
+
+/// @brief - Expand to each argument of a message prefixed by a comma
+/// and passed to `pge::log::details::capture`, along with whether it
+/// is spelled as a string literal (i.e. it starts with a quote). The
+/// arguments are split on their top level commas, so a type with a
+/// comma should be put in parentheses.
+# define PGE_LOG_CAPTURE(...)                                        \
+  __VA_OPT__(PGE_LOG_EXPAND(PGE_LOG_CAPTURE_EACH(__VA_ARGS__)))
+
+# define PGE_LOG_CAPTURE_EACH(arg, ...)                              \
+  , ::pge::log::details::capture<(#arg)[0] == '"'>(arg)               \
+  __VA_OPT__(PGE_LOG_CAPTURE_NEXT PGE_LOG_PARENS (__VA_ARGS__))
+
+# define PGE_LOG_CAPTURE_NEXT() PGE_LOG_CAPTURE_EACH
+# define PGE_LOG_PARENS ()
+
+/// @brief - Rescan the input enough times to capture 64 arguments.
+# define PGE_LOG_EXPAND(...) PGE_LOG_EXPAND_16(PGE_LOG_EXPAND_16(PGE_LOG_EXPAND_16(PGE_LOG_EXPAND_16(__VA_ARGS__))))
+# define PGE_LOG_EXPAND_16(...) PGE_LOG_EXPAND_4(PGE_LOG_EXPAND_4(PGE_LOG_EXPAND_4(PGE_LOG_EXPAND_4(__VA_ARGS__))))
+# define PGE_LOG_EXPAND_4(...) PGE_LOG_EXPAND_1(PGE_LOG_EXPAND_1(PGE_LOG_EXPAND_1(PGE_LOG_EXPAND_1(__VA_ARGS__))))
+# define PGE_LOG_EXPAND_1(...) __VA_ARGS__
+
+# define PGE_VERBOSE(...) PGE_LOG(utils::Level::Verbose, __VA_ARGS__)
+# define PGE_DEBUG(...) PGE_LOG(utils::Level::Debug, __VA_ARGS__)
+# define PGE_INFO(...) PGE_LOG(utils::Level::Info, __VA_ARGS__)
+# define PGE_NOTICE(...) PGE_LOG(utils::Level::Notice, __VA_ARGS__)
+# define PGE_WARN(...) PGE_LOG(utils::Level::Warning, __VA_ARGS__)
+# define PGE_ERROR(...) PGE_LOG(utils::Level::Error, __VA_ARGS__)
+
+# include "Log.hxx"
+
+#endif    /* LOG_HH */
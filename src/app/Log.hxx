@@ -0,0 +1,264 @@
+#ifndef    LOG_HXX
+# define   LOG_HXX
+
+# include "Log.hh"
+# include <new>
+# include <tuple>
+# include <sstream>
+
+namespace pge {
+  namespace log {
+
+    constexpr
+    bool
+    compiled(const utils::Level& level) noexcept {
+      return static_cast<int>(level) >= PGE_LOG_LEVEL;
+    }
+
+    template <typename T>
+    void
+    append(std::string& out, const T& value) {
+      if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        out += std::string_view(value);
+      }
+      else if constexpr (std::is_same_v<T, bool>) {
+        out += (value ? "true" : "false");
+      }
+      else if constexpr (std::is_same_v<T, char>) {
+        out += value;
+      }
+      else if constexpr (std::is_arithmetic_v<T>) {
+        out += std::to_string(value);
+      }
+      else if constexpr (requires { value.x; value.y; }) {
+        // Same output as the `str` method of the vectors
+        // but without the intermediate strings.
+        out += '(';
+        append(out, value.x);
+        out += ',';
+        append(out, value.y);
+        out += ')';
+      }
+      else if constexpr (requires { { value.str() } -> std::convertible_to<std::string>; }) {
+        out += value.str();
+      }
+      else {
+        std::ostringstream os;
+        os << value;
+        out += os.str();
+      }
+    }
+
+    template <typename... Args>
+    inline
+    void
+    push(const utils::Level& level,
+         const std::string& service,
+         const std::string& module,
+         Args&&... args)
+    {
+      if (!enabled(level)) {
+        return;
+      }
+
+      details::push(details::Record(level, service, module, std::forward<Args>(args)...));
+    }
+
+    namespace details {
+
+      inline
+      Literal::operator std::string_view() const noexcept {
+        return text;
+      }
+
+      template <bool IsLiteral, typename Arg>
+      inline
+      constexpr
+      decltype(auto)
+      capture(Arg&& arg) noexcept {
+        using Type = std::remove_reference_t<Arg>;
+
+        if constexpr (IsLiteral && std::is_array_v<Type> && std::is_same_v<std::remove_extent_t<Type>, const char>) {
+          return Literal{arg};
+        }
+        else {
+          return std::forward<Arg>(arg);
+        }
+      }
+
+      template <typename... Args>
+      inline
+      Record::Record(const utils::Level& level,
+                     const std::string& service,
+                     const std::string& module,
+                     Args&&... args):
+        m_level(level),
+        m_service(service),
+        m_module(module),
+
+        m_ops(&operations<std::tuple<Stored<Args>...>>()),
+
+        m_storage()
+      {
+        // Only string literals are kept as pointers (see the
+        // `capture` method), which stay valid until the record
+        // is formatted: any other argument is copied.
+        using Pack = std::tuple<Stored<Args>...>;
+
+        if (fits<Pack>()) {
+          new (m_storage.data()) Pack(std::forward<Args>(args)...);
+        }
+        else {
+          Pack* pack = new Pack(std::forward<Args>(args)...);
+          new (m_storage.data()) Pack*(pack);
+        }
+      }
+
+      inline
+      Record::Record(Record&& rhs) noexcept:
+        m_level(rhs.m_level),
+        m_service(std::move(rhs.m_service)),
+        m_module(std::move(rhs.m_module)),
+
+        m_ops(rhs.m_ops),
+
+        m_storage()
+      {
+        if (m_ops != nullptr) {
+          m_ops->move(rhs.arguments(), arguments());
+          rhs.m_ops = nullptr;
+        }
+      }
+
+      inline
+      Record&
+      Record::operator=(Record&& rhs) noexcept {
+        if (this == &rhs) {
+          return *this;
+        }
+
+        reset();
+
+        m_level = rhs.m_level;
+        m_service = std::move(rhs.m_service);
+        m_module = std::move(rhs.m_module);
+        m_ops = rhs.m_ops;
+
+        if (m_ops != nullptr) {
+          m_ops->move(rhs.arguments(), arguments());
+          rhs.m_ops = nullptr;
+        }
+
+        return *this;
+      }
+
+      inline
+      Record::~Record() {
+        reset();
+      }
+
+      inline
+      const utils::Level&
+      Record::level() const noexcept {
+        return m_level;
+      }
+
+      inline
+      const std::string&
+      Record::service() const noexcept {
+        return m_service;
+      }
+
+      inline
+      const std::string&
+      Record::module() const noexcept {
+        return m_module;
+      }
+
+      inline
+      std::string
+      Record::format() const {
+        std::string out;
+        if (m_ops != nullptr) {
+          m_ops->format(arguments(), out);
+        }
+
+        return out;
+      }
+
+      template <typename Pack>
+      inline
+      const Record::Operations&
+      Record::operations() noexcept {
+        // The arguments are either moved to the new storage
+        // when stored inline, or the pointer to their copy
+        // is transferred.
+        static const Operations ops{
+          [](const void* args, std::string& out) {
+            std::apply(
+              [&out](const auto&... values) {
+                (append(out, values), ...);
+              },
+              *static_cast<const Pack*>(args)
+            );
+          },
+          [](void* from, void* to) noexcept {
+            Pack* src = static_cast<Pack*>(from);
+            new (to) Pack(std::move(*src));
+            src->~Pack();
+          },
+          [](void* args) noexcept {
+            static_cast<Pack*>(args)->~Pack();
+          }
+        };
+
+        static const Operations indirect{
+          [](const void* args, std::string& out) {
+            ops.format(*static_cast<Pack* const*>(args), out);
+          },
+          [](void* from, void* to) noexcept {
+            new (to) Pack*(*static_cast<Pack**>(from));
+          },
+          [](void* args) noexcept {
+            delete *static_cast<Pack**>(args);
+          }
+        };
+
+        return (fits<Pack>() ? ops : indirect);
+      }
+
+      template <typename Pack>
+      inline
+      constexpr
+      bool
+      Record::fits() noexcept {
+        return sizeof(Pack) <= Storage && alignof(Pack) <= alignof(std::max_align_t);
+      }
+
+      inline
+      void*
+      Record::arguments() noexcept {
+        return m_storage.data();
+      }
+
+      inline
+      const void*
+      Record::arguments() const noexcept {
+        return m_storage.data();
+      }
+
+      inline
+      void
+      Record::reset() noexcept {
+        if (m_ops != nullptr) {
+          m_ops->destroy(arguments());
+          m_ops = nullptr;
+        }
+      }
+
+    }
+
+  }
+}
+
+#endif    /* LOG_HXX */
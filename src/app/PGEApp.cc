@@ -1,5 +1,7 @@
 
 # include "PGEApp.hh"
+# include "Allocations.hh"
+# include "Textures.hh"
 
 namespace pge {
 
@@ -14,16 +16,32 @@ namespace pge {
 
     m_debugOn(true),
     m_uiOn(true),
+    m_profilerOn(false),
 
     m_controls(controls::newState()),
     m_first(true),
+    m_uiDrawn(false),
 
     m_fixedFrame(desc.fixedFrame),
-    m_frame(desc.frame)
+    m_frame(desc.frame),
+    m_frameSlot(-1),
+
+    m_headless(nullptr),
+
+    m_timestep(desc.timestep),
+    m_maxFrames(desc.frames),
+    m_frames(0u),
+    m_uploadBudget(desc.uploadBudget),
+    m_timings(),
+    m_allocations(),
+
+    m_arena(),
+
+    m_profiler()
   {
     // Initialize the application settings.
     sAppName = desc.name;
-    setService("app");
+    setService(LogService);
 
     // Make sure that a coordinate frame is provided.
     if (m_frame == nullptr) {
@@ -33,10 +51,28 @@ namespace pge {
       );
     }
 
+    m_frameSlot = m_frame->onChanged.connect_member<PGEApp>(this, &PGEApp::onFrameSignal);
+
+    // Replace the window and the OpenGL context with an
+    // in-memory rendering if needed.
+    if (desc.headless) {
+      m_headless = headless::install(*this);
+      info("Using headless software renderer");
+    }
+
+    if (m_maxFrames > 0u) {
+      m_timings.reserve(m_maxFrames);
+      m_allocations.reserve(m_maxFrames);
+    }
+
     // Generate and construct the window.
     initialize(desc.dims, desc.pixRatio);
   }
 
+  PGEApp::~PGEApp() {
+    m_frame->onChanged.disconnect(m_frameSlot);
+  }
+
   bool
   PGEApp::OnUserCreate() {
     // The debug layer is the default layer: it is always
@@ -69,14 +105,41 @@ namespace pge {
 
   bool
   PGEApp::OnUserUpdate(float fElapsedTime) {
+    const utils::TimeStamp start = utils::now();
+    const std::uint64_t allocated = allocations::count();
+
+    // Use a fixed timestep if requested so that the
+    // runs are reproducible.
+    if (m_timestep > 0.0f) {
+      fElapsedTime = m_timestep;
+    }
+
     // Handle inputs.
-    InputChanges ic = handleInputs();
+    InputChanges ic;
+    {
+      ScopedTimer t(m_profiler, profiler::Inputs);
+      ic = handleInputs();
+    }
 
     // Handle user inputs.
-    onInputs(m_controls, *m_frame);
+    {
+      ScopedTimer t(m_profiler, profiler::UserInputs);
+      onInputs(m_controls, *m_frame);
+    }
 
     // Handle game logic.
-    bool quit = onFrame(fElapsedTime);
+    bool quit = false;
+    {
+      ScopedTimer t(m_profiler, profiler::Frame);
+      quit = onFrame(fElapsedTime);
+    }
+
+    // Send the textures decoded in the background
+    // before they are drawn.
+    {
+      ScopedTimer t(m_profiler, profiler::Uploads);
+      textures::upload(m_uploadBudget);
+    }
 
     // Handle rendering: for each function
     // we will assign the draw target first
@@ -95,19 +158,32 @@ namespace pge {
     // them: otherwise the window usually
     // stays black.
     SetDrawTarget(m_mDecalLayer);
-    drawDecal(res);
+    {
+      ScopedTimer t(m_profiler, profiler::DrawDecal);
+      drawDecal(res);
+    }
 
     SetDrawTarget(m_mLayer);
-    draw(res);
+    {
+      ScopedTimer t(m_profiler, profiler::Draw);
+      draw(res);
+    }
 
-    if (hasUI()) {
+    // Each layer has its own content: the menus are
+    // only part of the UI layer. When the UI is not
+    // drawn anymore the layer still holds the last
+    // menus so it is cleared once.
+    const bool ui = hasUI() || uiRequired();
+    if (ui) {
       SetDrawTarget(m_uiLayer);
+      ScopedTimer t(m_profiler, profiler::DrawUI);
       drawUI(res);
     }
-    if (!hasUI() && isFirstFrame()) {
+    if (!ui && (m_uiDrawn || isFirstFrame())) {
       SetDrawTarget(m_uiLayer);
       clearLayer();
     }
+    m_uiDrawn = ui;
 
     // Draw the debug layer. As it is saved
     // in the layer `0` we need to clear it
@@ -123,7 +199,16 @@ namespace pge {
     // updated.
     if (hasDebug()) {
       SetDrawTarget(m_dLayer);
-      drawDebug(res);
+      {
+        ScopedTimer t(m_profiler, profiler::DrawDebug);
+        drawDebug(res);
+      }
+
+      // The profiler is drawn on top of the debug
+      // elements and is not measured itself.
+      if (m_profilerOn) {
+        drawProfiler();
+      }
     }
     if (!hasDebug() && (ic.debugLayerToggled || isFirstFrame())) {
       SetDrawTarget(m_dLayer);
@@ -135,8 +220,153 @@ namespace pge {
 
     // Not the first frame anymore.
     m_first = false;
+    m_profiler.endFrame();
+
+    // Nothing allocated in the arena should outlive
+    // the frame.
+    m_arena.reset();
+
+    ++m_frames;
+    bool done = false;
+    if (m_maxFrames > 0u) {
+      m_timings.push_back(utils::diffInMs(start, utils::now()));
+      if (allocations::counted()) {
+        m_allocations.push_back(allocations::count() - allocated);
+      }
+      done = (m_frames >= m_maxFrames);
+    }
 
-    return !ic.quit && !quit;
+    return !ic.quit && !quit && !done;
+  }
+
+  bool
+  PGEApp::dumpLayer(const std::string& layer,
+                    const std::string& file)
+  {
+    if (layer == "frame") {
+      if (m_headless == nullptr) {
+        warn("Unable to dump frame to \"" + file + "\" for app which is not headless");
+        return false;
+      }
+
+      return headless::writePng(file, m_headless->frame().data(), m_headless->dims());
+    }
+
+    unsigned id = 0u;
+    if (layer == "decal") {
+      id = m_mDecalLayer;
+    }
+    else if (layer == "draw") {
+      id = m_mLayer;
+    }
+    else if (layer == "ui") {
+      id = m_uiLayer;
+    }
+    else if (layer == "debug") {
+      id = m_dLayer;
+    }
+    else {
+      warn("Unable to dump unknown layer \"" + layer + "\"");
+      return false;
+    }
+
+    const auto& layers = GetLayers();
+    if (id >= layers.size() || layers[id].pDrawTarget == nullptr) {
+      warn("Unable to dump layer \"" + layer + "\" which is not created");
+      return false;
+    }
+
+    olc::Sprite* spr = layers[id].pDrawTarget;
+    return headless::writePng(file, spr->GetData(), olc::vi2d(spr->width, spr->height));
+  }
+
+  void
+  PGEApp::drawProfiler() {
+    // Frames are displayed as stacked bars with the
+    // most recent on the right. The scale is chosen
+    // so that the budget of a frame at 60 fps is at
+    // half the height of the graph.
+    constexpr auto BUDGET_MS = 1000.0f / 60.0f;
+    constexpr auto BAR_WIDTH = 2;
+    constexpr auto GRAPH_HEIGHT = 80;
+    constexpr auto LINE_HEIGHT = 10;
+    constexpr auto MARGIN = 5;
+
+    static const std::array<olc::Pixel, profiler::PhasesCount> colors = {
+      olc::GREY,
+      olc::CYAN,
+      olc::GREEN,
+      olc::DARK_GREEN,
+      olc::YELLOW,
+      olc::ORANGE,
+      olc::MAGENTA,
+      olc::BLUE
+    };
+
+    const unsigned frames = m_profiler.frames();
+    const int width = BAR_WIDTH * std::max(frames, 1u);
+    const int textWidth = 8 * 34;
+    const int panelWidth = std::max(width, textWidth) + 2 * MARGIN;
+    const int panelHeight = GRAPH_HEIGHT + (profiler::PhasesCount + 1) * LINE_HEIGHT + 3 * MARGIN;
+
+    const olc::vi2d o(ScreenWidth() - panelWidth - MARGIN, MARGIN);
+
+    SetPixelMode(olc::Pixel::ALPHA);
+    FillRect(o, olc::vi2d(panelWidth, panelHeight), olc::Pixel(0, 0, 0, alpha::SemiOpaque));
+
+    const olc::vi2d g(o.x + MARGIN, o.y + MARGIN);
+    const float pixelsPerMs = GRAPH_HEIGHT / (2.0f * BUDGET_MS);
+
+    for (unsigned age = 0u ; age < frames ; ++age) {
+      const int x = g.x + width - BAR_WIDTH * (age + 1);
+      float total = 0.0f;
+
+      for (unsigned p = 0u ; p < profiler::PhasesCount ; ++p) {
+        const auto phase = static_cast<profiler::Phase>(p);
+        const float d = m_profiler.duration(phase, age);
+
+        const int top = static_cast<int>(std::min((total + d) * pixelsPerMs, 1.0f * GRAPH_HEIGHT));
+        const int bottom = static_cast<int>(std::min(total * pixelsPerMs, 1.0f * GRAPH_HEIGHT));
+        if (top > bottom) {
+          FillRect(x, g.y + GRAPH_HEIGHT - top, BAR_WIDTH, top - bottom, colors[p]);
+        }
+
+        total += d;
+      }
+    }
+
+    const int budget = g.y + GRAPH_HEIGHT - static_cast<int>(BUDGET_MS * pixelsPerMs);
+    DrawLine(g.x, budget, g.x + width, budget, olc::RED);
+
+    // Statistics for each phase.
+    const auto format = [](float v) {
+      std::string out = std::to_string(v);
+      return out.substr(0, out.find('.') + 3u);
+    };
+    const auto column = [](const std::string& str, unsigned size) {
+      return str.size() >= size ? str : str + std::string(size - str.size(), ' ');
+    };
+
+    int y = g.y + GRAPH_HEIGHT + MARGIN;
+    DrawString(olc::vi2d(g.x, y), "phase  min   avg   p95   max  (ms)", olc::WHITE);
+
+    for (unsigned p = 0u ; p < profiler::PhasesCount ; ++p) {
+      const auto phase = static_cast<profiler::Phase>(p);
+      const auto st = m_profiler.stats(phase);
+
+      y += LINE_HEIGHT;
+      const std::string line =
+        column(profiler::name(phase), 7u) +
+        column(format(st.min), 6u) +
+        column(format(st.avg), 6u) +
+        column(format(st.p95), 6u) +
+        format(st.max)
+      ;
+
+      DrawString(olc::vi2d(g.x, y), line, colors[p]);
+    }
+
+    SetPixelMode(olc::Pixel::NORMAL);
   }
 
   PGEApp::InputChanges
@@ -229,6 +459,17 @@ namespace pge {
     if (GetKey(olc::U).bReleased) {
       m_uiOn = !m_uiOn;
     }
+    if (GetKey(olc::T).bReleased) {
+      m_profilerOn = !m_profilerOn;
+    }
+    if (GetKey(olc::R).bReleased && trace::enabled()) {
+      if (trace::save("trace.json")) {
+        info("Saved trace to \"trace.json\"");
+      }
+      else {
+        warn("Failed to save trace to \"trace.json\"");
+      }
+    }
 
     return ic;
   }
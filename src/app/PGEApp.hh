@@ -1,12 +1,18 @@
 #ifndef    PGE_APP_HH
 # define   PGE_APP_HH
 
+# include <vector>
+# include <string>
 # include <core_utils/CoreObject.hh>
+# include <core_utils/TimeUtils.hh>
 # include <maths_utils/Point2.hh>
 # include "olcEngine.hh"
 # include "AppDesc.hh"
 # include "Frame.hh"
 # include "Controls.hh"
+# include "Headless.hh"
+# include "Profiler.hh"
+# include "Arena.hh"
 
 namespace pge {
 
@@ -24,7 +30,7 @@ namespace pge {
       /**
        * @brief - Desctruction of the object.
        */
-      ~PGEApp() = default;
+      ~PGEApp();
 
       /**
        * @brief - Implementation of the interface method called
@@ -53,8 +59,61 @@ namespace pge {
       bool
       OnUserDestroy() override;
 
+      /**
+       * @brief - Returns the software renderer used when the app
+       *          is headless. It allows to access the content of
+       *          the last frame displayed.
+       * @return - the software renderer or `nullptr` if the app
+       *           is rendered in a window.
+       */
+      const headless::Renderer*
+      headlessRenderer() const noexcept;
+
+      /**
+       * @brief - Returns the time spent in each frame so far in
+       *          milliseconds. It includes the processing of the
+       *          inputs, the game logic and the drawing passes
+       *          but not the presentation of the frame. Timings
+       *          are only collected when the number of frames of
+       *          the app is limited.
+       * @return - the duration of each frame.
+       */
+      const std::vector<float>&
+      timings() const noexcept;
+
+      /**
+       * @brief - Returns the number of allocations performed by
+       *          each frame so far. Like the timings they are only
+       *          collected when the number of frames is limited,
+       *          and when the allocations are counted (see the
+       *          `allocations::counted` method).
+       * @return - the number of allocations of each frame.
+       */
+      const std::vector<std::uint64_t>&
+      allocations() const noexcept;
+
+      /**
+       * @brief - Save the content of a layer as a PNG image. The
+       *          layers are identified by their name: `decal`,
+       *          `draw`, `ui` and `debug`. When the app renders
+       *          in memory (see `AppDesc::headless`) the final
+       *          composited frame is also available as `frame`.
+       * @param layer - the name of the layer to save.
+       * @param file - the path of the image to create.
+       * @return - `true` if the layer could be saved.
+       */
+      bool
+      dumpLayer(const std::string& layer,
+                const std::string& file);
+
     protected:
 
+      /**
+       * @brief - The service of the messages of this class, given
+       *          to `setService` and to the logging macros.
+       */
+      static constexpr const char* LogService = "app";
+
       /// @brief - Convenience define refering to a drawing layer.
       enum class Layer {
         Draw,
@@ -120,6 +179,15 @@ namespace pge {
       bool
       hasUI() const noexcept;
 
+      /**
+       * @brief - Returns the arena where the data needed only for
+       *          the current frame can be allocated. It is reset at
+       *          the end of each frame.
+       * @return - the arena of the frame.
+       */
+      Arena&
+      frameArena() noexcept;
+
       /**
        * @brief - Used to assign a certain tint to the layer
        *          defined by the input descriptor.
@@ -259,6 +327,28 @@ namespace pge {
       onInputs(const controls::State& c,
                const coordinates::Frame& cf) = 0;
 
+      /**
+       * @brief - Interface method called whenever the coordinate
+       *          frame is panned, zoomed or replaced. Allows the
+       *          inheriting classes to invalidate the data that
+       *          depends on the frame. The default implementation
+       *          does nothing.
+       * @param change - the kind of change applied to the frame.
+       */
+      virtual void
+      onFrameChanged(const coordinates::FrameChange& change);
+
+      /**
+       * @brief - Interface method allowing the inheriting classes
+       *          to force the display of the UI layer even if the
+       *          user hid it, for example when the app displays a
+       *          menu screen. The default implementation returns
+       *          `false`.
+       * @return - `true` if the UI layer should be drawn.
+       */
+      virtual bool
+      uiRequired() const noexcept;
+
     private:
 
       /// @brief - Used to keep track of the changes in the input
@@ -287,6 +377,21 @@ namespace pge {
       void
       initialize(const olc::vi2d& dims, const olc::vi2d& pixRatio);
 
+      /**
+       * @brief - Draw the durations of the phases of the last frames
+       *          and their statistics in the current draw target.
+       */
+      void
+      drawProfiler();
+
+      /**
+       * @brief - Used to listen to the changes of the coordinate
+       *          frame and forward them to the inheriting classes.
+       * @param change - the kind of change applied to the frame.
+       */
+      void
+      onFrameSignal(coordinates::FrameChange change);
+
       /**
        * @brief - Used to perform the necessary update based on
        *          the controls that the user might have used in
@@ -349,6 +454,12 @@ namespace pge {
        */
       bool m_uiOn;
 
+      /**
+       * @brief - Whether the durations of the phases of the frames
+       *          are displayed on top of the debug layer.
+       */
+      bool m_profilerOn;
+
       /**
        * @brief - A map to keep track of the state of the controls
        *          to be transmitted to the world's entities for
@@ -363,6 +474,13 @@ namespace pge {
        */
       bool m_first;
 
+      /**
+       * @brief - Whether the UI was drawn during the last frame:
+       *          the UI layer needs to be cleared on the frame it
+       *          stops being drawn.
+       */
+      bool m_uiDrawn;
+
       /**
        * @brief - Whether or not panning and zooming is allowed
        *          in this app.
@@ -376,6 +494,60 @@ namespace pge {
        *          screen coordinates and conversely.
        */
       coordinates::FrameShPtr m_frame;
+
+      /**
+       * @brief - The identifier of the connection to the change
+       *          signal of the coordinate frame.
+       */
+      int m_frameSlot;
+
+      /**
+       * @brief - The software renderer installed in the engine
+       *          when the app is headless.
+       */
+      headless::Renderer* m_headless;
+
+      /**
+       * @brief - The duration of a frame as seen by the app or
+       *          a value of zero or less to use the real time.
+       */
+      float m_timestep;
+
+      /**
+       * @brief - The number of frames to run (`0` to run until
+       *          the app is exited) and the number of frames run
+       *          so far.
+       */
+      unsigned m_maxFrames;
+      unsigned m_frames;
+
+      /**
+       * @brief - The number of bytes of textures which can be sent
+       *          to the renderer in a frame.
+       */
+      std::size_t m_uploadBudget;
+
+      /**
+       * @brief - The duration of each frame in milliseconds when
+       *          the number of frames is limited.
+       */
+      std::vector<float> m_timings;
+
+      /**
+       * @brief - The number of allocations of each frame when the
+       *          number of frames is limited.
+       */
+      std::vector<std::uint64_t> m_allocations;
+
+      /**
+       * @brief - The memory for the transient data of the frame.
+       */
+      Arena m_arena;
+
+      /**
+       * @brief - Measures the duration of the phases of the frames.
+       */
+      Profiler m_profiler;
   };
 
 }
@@ -26,6 +26,24 @@ namespace pge {
     return true;
   }
 
+  inline
+  const headless::Renderer*
+  PGEApp::headlessRenderer() const noexcept {
+    return m_headless;
+  }
+
+  inline
+  const std::vector<float>&
+  PGEApp::timings() const noexcept {
+    return m_timings;
+  }
+
+  inline
+  const std::vector<std::uint64_t>&
+  PGEApp::allocations() const noexcept {
+    return m_allocations;
+  }
+
   inline
   bool
   PGEApp::isFirstFrame() const noexcept {
@@ -44,6 +62,12 @@ namespace pge {
     return m_uiOn;
   }
 
+  inline
+  Arena&
+  PGEApp::frameArena() noexcept {
+    return m_arena;
+  }
+
   inline
   void
   PGEApp::setLayerTint(const Layer& layer, const olc::Pixel& tint) {
@@ -73,7 +97,27 @@ namespace pge {
     }
 
     info("Installing new coordinate frame for app");
+    m_frame->onChanged.disconnect(m_frameSlot);
     m_frame = frame;
+    m_frameSlot = m_frame->onChanged.connect_member<PGEApp>(this, &PGEApp::onFrameSignal);
+
+    onFrameChanged(coordinates::FrameChange::Replaced);
+  }
+
+  inline
+  void
+  PGEApp::onFrameChanged(const coordinates::FrameChange& /*change*/) {}
+
+  inline
+  bool
+  PGEApp::uiRequired() const noexcept {
+    return false;
+  }
+
+  inline
+  void
+  PGEApp::onFrameSignal(coordinates::FrameChange change) {
+    onFrameChanged(change);
   }
 
   inline
@@ -0,0 +1,86 @@
+
+# include "Profiler.hh"
+# include <algorithm>
+
+namespace pge {
+  namespace profiler {
+
+    const char*
+    name(const Phase& phase) noexcept {
+      switch (phase) {
+        case Inputs:
+          return "inputs";
+        case UserInputs:
+          return "user";
+        case Frame:
+          return "frame";
+        case Uploads:
+          return "upload";
+        case DrawDecal:
+          return "decal";
+        case Draw:
+          return "draw";
+        case DrawUI:
+          return "ui";
+        case DrawDebug:
+          return "debug";
+        default:
+          return "unknown";
+      }
+    }
+
+  }
+
+  Profiler::Profiler(unsigned window):
+    m_slots(std::max(window, 1u) + 1u),
+    m_durations(),
+    m_head(0u),
+    m_frames(0u),
+    m_sorted()
+  {
+    for (auto& durations : m_durations) {
+      durations.resize(m_slots, 0.0f);
+    }
+
+    m_sorted.reserve(m_slots);
+  }
+
+  void
+  Profiler::endFrame() noexcept {
+    m_head = (m_head + 1u) % m_slots;
+    m_frames = std::min(m_frames + 1u, m_slots - 1u);
+
+    for (auto& durations : m_durations) {
+      durations[m_head] = 0.0f;
+    }
+  }
+
+  profiler::Stats
+  Profiler::stats(const profiler::Phase& phase) const {
+    profiler::Stats out{0.0f, 0.0f, 0.0f, 0.0f};
+    if (m_frames == 0u) {
+      return out;
+    }
+
+    m_sorted.clear();
+    for (unsigned id = 0u ; id < m_frames ; ++id) {
+      m_sorted.push_back(duration(phase, id));
+    }
+
+    std::sort(m_sorted.begin(), m_sorted.end());
+
+    out.min = m_sorted.front();
+    out.max = m_sorted.back();
+
+    for (const auto& d : m_sorted) {
+      out.avg += d;
+    }
+    out.avg /= m_sorted.size();
+
+    const auto id = static_cast<unsigned>(0.95f * (m_sorted.size() - 1u) + 0.5f);
+    out.p95 = m_sorted[id];
+
+    return out;
+  }
+
+}
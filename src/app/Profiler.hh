@@ -0,0 +1,171 @@
+#ifndef    PROFILER_HH
+# define   PROFILER_HH
+
+# include <array>
+# include <chrono>
+# include <string>
+# include <vector>
+# include "Trace.hh"
+
+namespace pge {
+  namespace profiler {
+
+    /// @brief - The phases of a frame which are measured by the
+    /// profiler, in the order in which they are executed.
+    enum Phase {
+      Inputs,
+      UserInputs,
+      Frame,
+      Uploads,
+      DrawDecal,
+      Draw,
+      DrawUI,
+      DrawDebug,
+
+      PhasesCount
+    };
+
+    /**
+     * @brief - Returns a short name for the input phase. It is also
+     *          used to identify the phase in traces.
+     * @param phase - the phase for which the name should be returned.
+     * @return - the name of the phase.
+     */
+    const char*
+    name(const Phase& phase) noexcept;
+
+    /// @brief - Statistics about the duration of a phase over the
+    /// last frames, expressed in milliseconds.
+    struct Stats {
+      float min;
+      float avg;
+      float p95;
+      float max;
+    };
+
+  }
+
+  /// @brief - Keeps track of the duration of each phase of the frame
+  /// over a rolling window of the last frames.
+  class Profiler {
+    public:
+
+      /**
+       * @brief - Create a new profiler with no measures.
+       * @param window - the number of frames to keep track of.
+       */
+      Profiler(unsigned window = 120u);
+
+      /**
+       * @brief - Add the input duration to the phase for the current
+       *          frame. A phase measured several times in a frame sums
+       *          all the durations.
+       * @param phase - the phase which was measured.
+       * @param ms - the duration of the phase in milliseconds.
+       */
+      void
+      record(const profiler::Phase& phase, float ms) noexcept;
+
+      /**
+       * @brief - Completes the current frame and start a new one.
+       */
+      void
+      endFrame() noexcept;
+
+      /**
+       * @brief - Returns the number of frames that are available in
+       *          the rolling window.
+       * @return - the number of completed frames.
+       */
+      unsigned
+      frames() const noexcept;
+
+      /**
+       * @brief - Returns the duration of a phase for a completed frame.
+       * @param phase - the phase to query.
+       * @param age - the index of the frame, `0` being the last one.
+       *              It should be smaller than `frames()`.
+       * @return - the duration of the phase in milliseconds.
+       */
+      float
+      duration(const profiler::Phase& phase, unsigned age) const noexcept;
+
+      /**
+       * @brief - Compute statistics about the duration of a phase over
+       *          the completed frames.
+       * @param phase - the phase to query.
+       * @return - the statistics for this phase.
+       */
+      profiler::Stats
+      stats(const profiler::Phase& phase) const;
+
+    private:
+
+      /**
+       * @brief - The number of slots of the rolling window. It contains
+       *          one more slot than the window for the frame in progress.
+       */
+      unsigned m_slots;
+
+      /**
+       * @brief - The durations of each phase, indexed by slot.
+       */
+      std::array<std::vector<float>, profiler::PhasesCount> m_durations;
+
+      /**
+       * @brief - The slot of the frame in progress.
+       */
+      unsigned m_head;
+
+      /**
+       * @brief - The number of completed frames in the window.
+       */
+      unsigned m_frames;
+
+      /**
+       * @brief - Temporary storage used to compute percentiles.
+       */
+      mutable std::vector<float> m_sorted;
+  };
+
+  /// @brief - Measures the time spent in its scope and records it for
+  /// a phase of the profiler. The scope is also added to the trace when
+  /// it is recorded (see `trace::enable`).
+  class ScopedTimer {
+    public:
+
+      /**
+       * @brief - Start measuring the duration of a phase.
+       * @param profiler - the profiler where the duration is recorded.
+       * @param phase - the phase being measured.
+       */
+      ScopedTimer(Profiler& profiler, const profiler::Phase& phase) noexcept;
+
+      ~ScopedTimer();
+
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+
+      Profiler& m_profiler;
+      profiler::Phase m_phase;
+
+      /**
+       * @brief - The scope of the phase in the trace.
+       */
+      trace::Scope m_scope;
+
+      /**
+       * @brief - The start of the measure. A monotonic clock is used
+       *          so that measures are not affected by changes of the
+       *          system time.
+       */
+      std::chrono::steady_clock::time_point m_start;
+  };
+
+}
+
+# include "Profiler.hxx"
+
+#endif    /* PROFILER_HH */
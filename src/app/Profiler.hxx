@@ -0,0 +1,42 @@
+#ifndef    PROFILER_HXX
+# define   PROFILER_HXX
+
+# include "Profiler.hh"
+
+namespace pge {
+
+  inline
+  void
+  Profiler::record(const profiler::Phase& phase, float ms) noexcept {
+    m_durations[phase][m_head] += ms;
+  }
+
+  inline
+  unsigned
+  Profiler::frames() const noexcept {
+    return m_frames;
+  }
+
+  inline
+  float
+  Profiler::duration(const profiler::Phase& phase, unsigned age) const noexcept {
+    return m_durations[phase][(m_head + m_slots - 1u - age) % m_slots];
+  }
+
+  inline
+  ScopedTimer::ScopedTimer(Profiler& profiler, const profiler::Phase& phase) noexcept:
+    m_profiler(profiler),
+    m_phase(phase),
+    m_scope(profiler::name(phase)),
+    m_start(std::chrono::steady_clock::now())
+  {}
+
+  inline
+  ScopedTimer::~ScopedTimer() {
+    const auto end = std::chrono::steady_clock::now();
+    m_profiler.record(m_phase, std::chrono::duration<float, std::milli>(end - m_start).count());
+  }
+
+}
+
+#endif    /* PROFILER_HXX */
@@ -1,52 +1,275 @@
 
 # include "TexturePack.hh"
+# include <chrono>
+# include <algorithm>
+# include <functional>
+# include "Trace.hh"
+# include "Log.hh"
+
+namespace {
+
+  /// @brief - Halve the size of each sprite of a pack: each texel is
+  /// the average of a 2x2 block of the input, weighted by the alpha so
+  /// that transparent texels do not darken the borders of the sprites.
+  std::unique_ptr<olc::Sprite>
+  downsample(const olc::Sprite& in,
+             const olc::vi2d& layout,
+             const olc::vi2d& from,
+             const olc::vi2d& to)
+  {
+    auto out = std::make_unique<olc::Sprite>(layout.x * to.x, layout.y * to.y);
+
+    for (int cy = 0 ; cy < layout.y ; ++cy) {
+      for (int cx = 0 ; cx < layout.x ; ++cx) {
+        const olc::vi2d src(cx * from.x, cy * from.y);
+        const olc::vi2d dst(cx * to.x, cy * to.y);
+
+        for (int y = 0 ; y < to.y ; ++y) {
+          for (int x = 0 ; x < to.x ; ++x) {
+            unsigned r = 0u, g = 0u, b = 0u, a = 0u;
+
+            // Blocks are clamped to the sprite when its size
+            // is odd or already a single texel.
+            for (int dy = 0 ; dy < 2 ; ++dy) {
+              for (int dx = 0 ; dx < 2 ; ++dx) {
+                const olc::Pixel p = in.GetPixel(
+                  src.x + std::min(2 * x + dx, from.x - 1),
+                  src.y + std::min(2 * y + dy, from.y - 1)
+                );
+
+                r += p.r * p.a;
+                g += p.g * p.a;
+                b += p.b * p.a;
+                a += p.a;
+              }
+            }
+
+            olc::Pixel c = olc::BLANK;
+            if (a > 0u) {
+              c = olc::Pixel(r / a, g / a, b / a, a / 4u);
+            }
+
+            out->SetPixel(dst.x + x, dst.y + y, c);
+          }
+        }
+      }
+    }
+
+    return out;
+  }
+
+  /// @brief - Whether the result of a job run in the background is
+  /// available.
+  template <typename T>
+  bool
+  ready(const std::shared_future<T>& result) {
+    return result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+  }
+
+  /// @brief - Compute the versions of the sprites of a pack in the
+  /// background. The first version is the image itself and each one
+  /// is obtained from the previous one until the sprites are a single
+  /// texel: this needs about a third more memory than the image.
+  std::shared_future<std::vector<pge::ImageShPtr>>
+  levels(pge::ImageShPtr image,
+         const olc::vi2d& layout,
+         const olc::vi2d& sSize)
+  {
+    auto task = std::make_shared<std::packaged_task<std::vector<pge::ImageShPtr>()>>(
+      [image, layout, sSize] {
+        pge::trace::Scope scope("TexturePack::levels");
+
+        std::vector<pge::ImageShPtr> images(1u, image);
+        olc::vi2d size = sSize;
+
+        while (size.x > 1 || size.y > 1) {
+          const olc::vi2d half(std::max(size.x / 2, 1), std::max(size.y / 2, 1));
+          images.push_back(downsample(*images.back(), layout, size, half));
+
+          size = half;
+        }
+
+        return images;
+      }
+    );
+
+    auto images = task->get_future().share();
+    pge::textures::schedule([task] { (*task)(); });
+
+    return images;
+  }
+
+}
 
 namespace pge {
 
   TexturePack::TexturePack():
     utils::CoreObject("pack"),
 
-    m_packs()
+    m_packs(),
+    m_atlas(),
+
+    m_placeholder(),
+    m_pending(),
+
+    m_batch(),
+    m_batchSize(0u)
   {
-    setService("textures");
+    setService(LogService);
   }
 
   TexturePack::~TexturePack() {
-    for (unsigned id = 0 ; id < m_packs.size() ; ++id) {
-      if (m_packs[id].res != nullptr) {
-        delete m_packs[id].res;
-      }
-    }
-
+    // The decals are released by the atlas.
     m_packs.clear();
   }
 
   unsigned
   TexturePack::registerPack(const sprites::Pack& pack) {
-    // Load the file as a sprite and then convert it
-    // to a faster `Decal` resource.
-    olc::Sprite* spr = new olc::Sprite(pack.file);
-    if (spr == nullptr) {
-      error(
-        "Failed to load texture pack \"" + pack.file + "\"",
-        "Loading returned null"
-      );
-    }
+    trace::Scope scope("TexturePack::registerPack");
 
     // Build the internal structure, register it and
     // return the corresponding identifier.
     Pack p;
+    p.file = pack.file;
     p.sSize = pack.sSize;
     p.layout = pack.layout;
 
-    p.res = new olc::Decal(spr);
+    // A pack registered again shares the sprites of the
+    // first registration: its image is not needed.
+    const bool shared = (find(p, true) != nullptr);
+    if (!shared) {
+      p.image = textures::request(pack.file);
+    }
 
     unsigned id = m_packs.size();
     m_packs.push_back(p);
 
+    if (shared) {
+      build(m_packs[id]);
+      return id;
+    }
+
+    if (progress(m_packs[id])) {
+      return id;
+    }
+
+    // The placeholder is a single texel: it is stretched
+    // over the area of each sprite.
+    if (m_placeholder == nullptr) {
+      m_placeholder = textures::placeholder();
+
+      m_pending.res = m_placeholder.get();
+      m_pending.pos = olc::vi2d(0, 0);
+      m_pending.size = olc::vi2d(1, 1);
+      m_pending.uvTL = olc::vf2d(0.0f, 0.0f);
+      m_pending.uvBR = olc::vf2d(1.0f, 1.0f);
+    }
+
+    m_packs[id].levels.push_back(Level{
+      m_pending.size,
+      m_pending.res,
+      m_pending.pos,
+      0u
+    });
+
     return id;
   }
 
+  unsigned
+  TexturePack::update() {
+    unsigned built = 0u;
+
+    for (Pack& p : m_packs) {
+      if (pending(p) && progress(p)) {
+        ++built;
+      }
+    }
+
+    return built;
+  }
+
+  bool
+  TexturePack::progress(Pack& p) {
+    if (!p.images.valid()) {
+      if (!textures::ready(p.image)) {
+        return false;
+      }
+
+      // Packs waiting for the same image share the versions
+      // computed from it.
+      if (const Pack* e = find(p, false)) {
+        p.images = e->images;
+      }
+      else {
+        ImageShPtr image = p.image.get();
+        if (image == nullptr) {
+          error(
+            "Failed to load texture pack \"" + p.file + "\"",
+            "Loading returned an empty image"
+          );
+        }
+
+        p.images = levels(image, p.layout, p.sSize);
+      }
+    }
+
+    if (!ready(p.images)) {
+      return false;
+    }
+
+    build(p);
+
+    return true;
+  }
+
+  void
+  TexturePack::build(Pack& p) {
+    trace::Scope scope("TexturePack::build");
+
+    // Packs registered while the image was decoded are
+    // built from the first one.
+    if (const Pack* e = find(p, true)) {
+      p.levels = e->levels;
+    }
+    else {
+      const std::vector<ImageShPtr>& images = p.images.get();
+
+      p.levels.clear();
+
+      Level l;
+      l.sSize = p.sSize;
+
+      for (const ImageShPtr& image : images) {
+        l.region = m_atlas.add(*image);
+
+        const atlas::Region& r = m_atlas.region(l.region);
+        l.res = r.res;
+        l.origin = r.pos;
+        p.levels.push_back(l);
+
+        l.sSize = olc::vi2d(std::max(l.sSize.x / 2, 1), std::max(l.sSize.y / 2, 1));
+      }
+
+      // Send the levels right away to the renderer.
+      m_atlas.upload();
+    }
+
+    p.image = ImageFuture();
+    p.images = std::shared_future<std::vector<ImageShPtr>>();
+  }
+
+  const TexturePack::Pack*
+  TexturePack::find(const Pack& pack, bool built) const noexcept {
+    for (const Pack& e : m_packs) {
+      const bool candidate = (built ? !pending(e) : e.images.valid());
+      if (&e != &pack && candidate && e.file == pack.file && e.sSize == pack.sSize && e.layout == pack.layout) {
+        return &e;
+      }
+    }
+
+    return nullptr;
+  }
+
   olc::Decal*
   TexturePack::getDecalForPack(const unsigned packID) const {
     if (packID >= m_packs.size()) {
@@ -56,29 +279,140 @@ namespace pge {
       );
     }
 
-    return m_packs[packID].res;
+    return m_packs[packID].levels[0].res;
+  }
+
+  const atlas::Region&
+  TexturePack::getRegionForPack(const unsigned packID) const {
+    if (packID >= m_packs.size()) {
+      error(
+        "Unable to find region associated to pack " + std::to_string(packID),
+        "Only " + std::to_string(m_packs.size()) + " pack(s) available"
+      );
+    }
+
+    const Pack& tp = m_packs[packID];
+    if (pending(tp)) {
+      return m_pending;
+    }
+
+    return m_atlas.region(tp.levels[0].region);
+  }
+
+  const atlas::Region&
+  TexturePack::getRegionForPack(const unsigned packID,
+                                const olc::vf2d& scale) const
+  {
+    if (packID >= m_packs.size()) {
+      error(
+        "Unable to find region associated to pack " + std::to_string(packID),
+        "Only " + std::to_string(m_packs.size()) + " pack(s) available"
+      );
+    }
+
+    const Pack& tp = m_packs[packID];
+    if (pending(tp)) {
+      return m_pending;
+    }
+
+    return m_atlas.region(tp.levels[level(tp, scale)].region);
   }
 
   void
   TexturePack::draw(olc::PixelGameEngine* pge,
                     const sprites::Sprite& s,
                     const olc::vf2d& p,
-                    const olc::vf2d& scale) const
+                    const olc::vf2d& scale,
+                    int layer,
+                    float depth) const
   {
     // Check whether the pack is valid.
     if (s.pack >= m_packs.size()) {
-      log(
-        "Unable to draw sprite from pack " + std::to_string(s.pack),
-        utils::Level::Error
-      );
+      PGE_ERROR("Unable to draw sprite from pack ", s.pack);
 
       return;
     }
 
     const Pack& tp = m_packs[s.pack];
 
-    olc::vi2d sCoords = spriteCoords(tp, s.sprite, s.id);
-    pge->DrawPartialDecal(p, tp.res, sCoords, tp.sSize, scale, s.tint);
+    // Smaller levels are scaled up to cover the same area
+    // as the original sprite.
+    const unsigned lID = level(tp, scale);
+    const Level& l = tp.levels[lID];
+
+    olc::vi2d sCoords = spriteCoords(tp, s.sprite, s.id, lID);
+    olc::vf2d lScale(
+      scale.x * tp.sSize.x / l.sSize.x,
+      scale.y * tp.sSize.y / l.sSize.y
+    );
+
+    if (!m_batch) {
+      pge->DrawPartialDecal(p, l.res, sCoords, l.sSize, lScale, s.tint);
+      return;
+    }
+
+    m_batch->push_back(Batched{
+      layer,
+      depth,
+      l.res,
+      l.sSize,
+      static_cast<unsigned>(m_batch->size()),
+
+      p,
+      sCoords,
+      lScale,
+      s.tint
+    });
+  }
+
+  unsigned
+  TexturePack::flush(olc::PixelGameEngine* pge) {
+    trace::Scope scope("TexturePack::flush");
+
+    if (!m_batch) {
+      return 0u;
+    }
+
+    auto& batch = *m_batch;
+
+    // The position in the batch is used as a last key so
+    // that the sort is stable without a temporary buffer.
+    auto before = [](const Batched& lhs, const Batched& rhs) {
+      if (lhs.layer != rhs.layer) {
+        return lhs.layer < rhs.layer;
+      }
+      if (lhs.depth != rhs.depth) {
+        return lhs.depth < rhs.depth;
+      }
+      if (lhs.res != rhs.res) {
+        return std::less<const olc::Decal*>()(lhs.res, rhs.res);
+      }
+
+      return lhs.order < rhs.order;
+    };
+
+    if (!std::is_sorted(batch.begin(), batch.end(), before)) {
+      std::sort(batch.begin(), batch.end(), before);
+    }
+
+    unsigned runs = 0u;
+    const olc::Decal* res = nullptr;
+
+    for (const Batched& b : batch) {
+      if (b.res != res) {
+        res = b.res;
+        ++runs;
+      }
+
+      pge->DrawPartialDecal(b.pos, b.res, b.source, b.size, b.scale, b.tint);
+    }
+
+    // The memory of the batch is released with the
+    // resource it was allocated from.
+    m_batchSize = batch.size();
+    m_batch.reset();
+
+    return runs;
   }
 
 }
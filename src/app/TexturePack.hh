@@ -2,8 +2,13 @@
 # define   TEXTURE_PACK_HH
 
 # include <memory>
+# include <vector>
+# include <optional>
+# include <memory_resource>
 # include <core_utils/CoreObject.hh>
 # include "olcEngine.hh"
+# include "Atlas.hh"
+# include "Textures.hh"
 
 namespace pge {
   namespace sprites {
@@ -71,7 +76,15 @@ namespace pge {
        * @brief - Performs the registration of the input pack
        *          and return the corresponding pack identifier
        *          so that the caller can refer to this pack
-       *          afterwards.
+       *          afterwards. The sprites of the pack are copied
+       *          in the atlas of the texture pack, so that packs
+       *          may share the same texture, along with smaller
+       *          versions of themselves used when they are drawn
+       *          with a small scale. Registering the same pack
+       *          again reuses these sprites.
+       *          When images are decoded in the background the
+       *          pack is drawn with a placeholder until `update`
+       *          finds its image decoded.
        * @param pack - the pack to load.
        * @return - an identifier allowing to reference this
        *           pack for later use.
@@ -79,10 +92,22 @@ namespace pge {
       unsigned
       registerPack(const sprites::Pack& pack);
 
+      /**
+       * @brief - Build the sprites of the packs whose image was
+       *          decoded since the last call. This should be called
+       *          once per frame, before drawing the packs. An error
+       *          is raised if the image of a pack cannot be loaded.
+       * @return - the number of packs which are now available.
+       */
+      unsigned
+      update();
+
       /**
        * @brief - Return the decal associated to the pack with
        *          the corresponding identifier. In case no such
-       *          pack exists, an error is returned.
+       *          pack exists, an error is returned. Note that
+       *          the decal may hold other packs: the area of
+       *          the pack is given by `getRegionForPack`.
        * @param packID - the identifier of the pack for which
        *                 the decal should be returned.
        * @return - the decal pointer associated to the pack.
@@ -90,6 +115,29 @@ namespace pge {
       olc::Decal*
       getDecalForPack(const unsigned packID) const;
 
+      /**
+       * @brief - Return the area of the decal holding the pack
+       *          with the corresponding identifier. In case no
+       *          such pack exists, an error is returned.
+       * @param packID - the identifier of the pack.
+       * @return - the region of the atlas holding the pack.
+       */
+      const atlas::Region&
+      getRegionForPack(const unsigned packID) const;
+
+      /**
+       * @brief - Similar to the above method but returns the area of
+       *          the smallest version of the pack which still has at
+       *          least one texel per pixel when drawn with the input
+       *          scale.
+       * @param packID - the identifier of the pack.
+       * @param scale - the scale applied to the pack when drawing it.
+       * @return - the region of the atlas holding this version.
+       */
+      const atlas::Region&
+      getRegionForPack(const unsigned packID,
+                       const olc::vf2d& scale) const;
+
       /**
        * @brief - Used to perform the drawing of the sprite as
        *          defined by the input argument using the engine.
@@ -107,6 +155,30 @@ namespace pge {
            const olc::vf2d& p,
            const olc::vf2d& scale = olc::vf2d(1.0f, 1.0f)) const;
 
+      /**
+       * @brief - Variant of the above method which also defines
+       *          the order of the sprite when batching: sprites
+       *          are drawn by increasing layer, then by depth.
+       *          Sprites which do not overlap should use the same
+       *          depth so that they can be grouped by pack. When
+       *          not batching the sprite is drawn directly and the
+       *          order is ignored.
+       * @param pge - the engine to use to perform the rendering.
+       * @param s - the sprite to draw.
+       * @param p - the position where the sprite will be drawn.
+       * @param scale - defines a scaling factor to apply to the
+       *                sprite.
+       * @param layer - the layer of the sprite.
+       * @param depth - the depth of the sprite in its layer.
+       */
+      void
+      draw(olc::PixelGameEngine* pge,
+           const sprites::Sprite& s,
+           const olc::vf2d& p,
+           const olc::vf2d& scale,
+           int layer,
+           float depth) const;
+
       /**
        * @brief - Variant of the above method to accept a scale
        *          expressed as a single float: the scale will be
@@ -124,13 +196,72 @@ namespace pge {
            const olc::vf2d& p,
            float scale = 1.0f) const;
 
+      /**
+       * @brief - Start collecting the sprites instead of drawing
+       *          them directly: they are submitted to the engine
+       *          on the next call to `flush`. This allows to draw
+       *          all the sprites of a pack in a single run, rather
+       *          than switching textures for each sprite.
+       * @param resource - the memory used to collect the sprites,
+       *                   as the arena of the frame: it should be
+       *                   valid until `flush` is called.
+       */
+      void
+      beginBatch(std::pmr::memory_resource* resource);
+
+      /**
+       * @brief - Draw the sprites collected since `beginBatch` and
+       *          stop collecting. The sprites are sorted by layer,
+       *          depth and texture: sprites with the same order
+       *          keep the order in which they were drawn. As packs
+       *          share the pages of the atlas, sorting on the pack
+       *          would split the runs of a texture.
+       * @param pge - the engine to use to perform the rendering.
+       * @return - the number of runs of sprites using the same
+       *           texture which were submitted.
+       */
+      unsigned
+      flush(olc::PixelGameEngine* pge);
+
     private:
 
+      /**
+       * @brief - The service of the messages of this class, given
+       *          to `setService` and to the logging macros.
+       */
+      static constexpr const char* LogService = "textures";
+
+      /// @brief - A version of the sprites of a pack, each level
+      /// being half the size of the previous one.
+      struct Level {
+        // The `sSize` defines the size of an individual sprite
+        // at this level.
+        olc::vi2d sSize;
+
+        // The `res` defines the raw data to the whole sprites
+        // registered for this level. Individual parts describe
+        // each sprite. It is owned by the atlas and may hold
+        // other packs.
+        olc::Decal* res;
+
+        // The `origin` defines the position of the level in the
+        // decal.
+        olc::vi2d origin;
+
+        // The `region` defines the handle of the level in the
+        // atlas.
+        atlas::Handle region;
+      };
+
       /// @brief - Convenience structure referencing the needed
       /// information to describe a texture pack. Unlike the
       /// public interface this contains the values used internally
       /// to define the pack.
       struct Pack {
+        // The `file` defines the file from which the sprites
+        // were loaded.
+        std::string file;
+
         // The `sSize` defines the size of an individual sprite
         // in the pack.
         olc::vi2d sSize;
@@ -139,12 +270,59 @@ namespace pge {
         // in the pack.
         olc::vi2d layout;
 
-        // The `res` defines the raw data to the whole sprites
-        // registered for this pack. Individual parts describe
-        // each sprite.
-        olc::Decal* res;
+        // The `levels` define the versions of the pack, from
+        // the original one down to sprites of a single pixel.
+        // Until the image is decoded it only holds a level for
+        // the placeholder.
+        std::vector<Level> levels;
+
+        // The `image` defines the image being decoded for the
+        // pack and the `images` the versions computed from it in
+        // the background. Both are reset once the levels are built.
+        ImageFuture image;
+        std::shared_future<std::vector<ImageShPtr>> images;
       };
 
+      /**
+       * @brief - Move the pack to the next step of its loading once
+       *          the previous one is done in the background: compute
+       *          the versions of its image when it is decoded, then
+       *          build its levels.
+       * @param pack - the pack waiting for its image.
+       * @return - `true` if the levels of the pack are built.
+       */
+      bool
+      progress(Pack& pack);
+
+      /**
+       * @brief - Copy the versions of the image of the pack in the
+       *          atlas, or share the levels of a pack already built
+       *          from the same file.
+       * @param pack - the pack to build.
+       */
+      void
+      build(Pack& pack);
+
+      /**
+       * @brief - Find another pack with the same sprites as the input
+       *          one, either already built or with its versions being
+       *          computed.
+       * @param pack - the pack to look for.
+       * @param built - whether the pack to find should be built.
+       * @return - the pack or `null` if there is none.
+       */
+      const Pack*
+      find(const Pack& pack,
+           bool built) const noexcept;
+
+      /**
+       * @brief - Whether the pack is still waiting for its image.
+       * @param pack - the pack to check.
+       * @return - `true` if the pack is drawn with the placeholder.
+       */
+      bool
+      pending(const Pack& pack) const noexcept;
+
       /**
        * @brief - Used to convert from sprite coordinates to the
        *          corresponding pixels coordinates. This method
@@ -163,13 +341,48 @@ namespace pge {
        *                to pixels in the resource pack.
        * @param id - the index of the variation of the sprite
        *             to use: default is `0`.
+       * @param level - the version of the pack to use.
        * @return - a vector representing the pixels coordinates
        *           for the input sprite coords.
        */
       olc::vi2d
       spriteCoords(const Pack& pack,
                    const olc::vi2d& coord,
-                   int id = 0) const;
+                   int id = 0,
+                   unsigned level = 0u) const;
+
+      /**
+       * @brief - Select the version of the pack to draw with the
+       *          input scale: this is the smallest version having
+       *          at least one texel per pixel.
+       * @param pack - the texture pack to draw.
+       * @param scale - the scale applied to the original sprites.
+       * @return - the index of the level to use.
+       */
+      unsigned
+      level(const Pack& pack,
+            const olc::vf2d& scale) const noexcept;
+
+      /// @brief - A sprite waiting to be drawn in a batch, with its
+      /// area in the pack already computed.
+      struct Batched {
+        int layer;
+        float depth;
+
+        // The `res` is the page of the atlas holding the level
+        // of the sprite, resolved when the sprite is drawn.
+        olc::Decal* res;
+        olc::vi2d size;
+
+        // The `order` is the position of the sprite in the
+        // batch, used to keep the sort stable.
+        unsigned order;
+
+        olc::vf2d pos;
+        olc::vi2d source;
+        olc::vf2d scale;
+        olc::Pixel tint;
+      };
 
     private:
 
@@ -180,6 +393,31 @@ namespace pge {
        *          the pack in this vector.
        */
       std::vector<Pack> m_packs;
+
+      /**
+       * @brief - The textures holding the sprites of the packs.
+       */
+      Atlas m_atlas;
+
+      /**
+       * @brief - The texture drawn for the packs which are not
+       *          built yet, and its area. It is only requested
+       *          when a pack needs it.
+       */
+      TextureShPtr m_placeholder;
+      atlas::Region m_pending;
+
+      /**
+       * @brief - The sprites collected in the current batch, when
+       *          they are collected rather than drawn.
+       */
+      mutable std::optional<std::pmr::vector<Batched>> m_batch;
+
+      /**
+       * @brief - The number of sprites of the last batch, used to
+       *          reserve the memory of the next one at once.
+       */
+      std::size_t m_batchSize;
   };
 
   using TexturePackShPtr = std::shared_ptr<TexturePack>;
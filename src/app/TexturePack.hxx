@@ -2,6 +2,8 @@
 # define   TEXTURE_PACK_HXX
 
 # include "TexturePack.hh"
+# include <cmath>
+# include <algorithm>
 # include "utils.hh"
 
 namespace pge {
@@ -16,23 +18,67 @@ namespace pge {
     draw(pge, s, p, olc::vf2d(scale, scale));
   }
 
+  inline
+  void
+  TexturePack::draw(olc::PixelGameEngine* pge,
+                    const sprites::Sprite& s,
+                    const olc::vf2d& p,
+                    const olc::vf2d& scale) const
+  {
+    draw(pge, s, p, scale, 0, 0.0f);
+  }
+
+  inline
+  void
+  TexturePack::beginBatch(std::pmr::memory_resource* resource) {
+    m_batch.emplace(resource);
+    m_batch->reserve(m_batchSize);
+  }
+
+  inline
+  bool
+  TexturePack::pending(const Pack& pack) const noexcept {
+    return pack.image.valid();
+  }
+
   inline
   olc::vi2d
   TexturePack::spriteCoords(const Pack& pack,
                             const olc::vi2d& coord,
-                            int id) const
+                            int id,
+                            unsigned level) const
   {
     int lID = coord.y * pack.layout.x + coord.x + id;
+    const Level& l = pack.levels[level];
 
     // Go back to 2D coordinates using the layout on
     // the linearized ID and the size of the sprite
     // to obtain a pixels position.
-    return olc::vi2d(
-      (lID % pack.layout.x) * pack.sSize.x,
-      (lID / pack.layout.x) * pack.sSize.y
+    return l.origin + olc::vi2d(
+      (lID % pack.layout.x) * l.sSize.x,
+      (lID / pack.layout.x) * l.sSize.y
     );
   }
 
+  inline
+  unsigned
+  TexturePack::level(const Pack& pack,
+                     const olc::vf2d& scale) const noexcept
+  {
+    // Each level halves the size of the sprites: move to
+    // the next one as long as it is still larger than the
+    // area covered on screen.
+    float s = std::max(std::abs(scale.x), std::abs(scale.y));
+
+    unsigned l = 0u;
+    while (l + 1u < pack.levels.size() && s <= 0.5f) {
+      s *= 2.0f;
+      ++l;
+    }
+
+    return l;
+  }
+
 }
 
 #endif    /* TEXTURE_PACK_HXX */
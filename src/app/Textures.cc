@@ -0,0 +1,386 @@
+
+# include "Textures.hh"
+# include <mutex>
+# include <algorithm>
+# include <deque>
+# include <atomic>
+# include <chrono>
+# include <thread>
+# include <functional>
+# include <vector>
+# include <filesystem>
+# include <unordered_map>
+# include <condition_variable>
+# include "Trace.hh"
+# include "Log.hh"
+
+namespace {
+
+  /// @brief - A texture showing the placeholder until its image is
+  /// decoded. The texture is not kept alive while waiting.
+  struct Upload {
+    std::weak_ptr<olc::Decal> texture;
+    pge::ImageFuture image;
+  };
+
+  /// @brief - Release a texture along with its image. The image is
+  /// set when it is uploaded for textures created with the placeholder.
+  struct Release {
+    pge::ImageShPtr image;
+
+    void
+    operator()(olc::Decal* res) {
+      delete res;
+
+      // The deleter lives as long as the weak references
+      // in the cache so the image is released explicitly.
+      image.reset();
+    }
+  };
+
+  /// @brief - The images and textures currently in use, indexed by the
+  /// canonical path of their file. Only weak references are kept so
+  /// that they are released with their last user: expired entries are
+  /// removed on the next lookup of the same file.
+  struct Cache {
+    std::mutex lock;
+
+    std::unordered_map<std::string, std::weak_ptr<const olc::Sprite>> images;
+    std::unordered_map<std::string, std::weak_ptr<olc::Decal>> textures;
+    std::weak_ptr<olc::Decal> placeholder;
+
+    // The images being decoded, until they are added to
+    // the `images`.
+    std::unordered_map<std::string, pge::ImageFuture> loading;
+
+    std::deque<std::function<void()>> jobs;
+    std::condition_variable wake;
+    std::vector<std::thread> workers;
+    bool running = false;
+
+    // Only accessed by the render thread.
+    std::vector<Upload> uploads;
+
+    unsigned decoded = 0u;
+    std::atomic<unsigned> uploaded = 0u;
+  };
+
+  Cache&
+  cache() {
+    static Cache c;
+    return c;
+  }
+
+  std::string
+  canonical(const std::string& file) {
+    std::error_code err;
+    std::filesystem::path p = std::filesystem::weakly_canonical(file, err);
+
+    return (err ? file : p.string());
+  }
+
+  olc::Sprite*
+  placeholderImage() {
+    static const std::unique_ptr<olc::Sprite> image = [] {
+      auto img = std::make_unique<olc::Sprite>(1, 1);
+      img->SetPixel(0, 0, olc::Pixel(128, 128, 128, 96));
+
+      return img;
+    }();
+
+    return image.get();
+  }
+
+  pge::ImageShPtr
+  decode(const std::string& key,
+         const std::string& file)
+  {
+    // Decode the file without holding the lock: another
+    // thread may have done the same in the meantime, in
+    // which case its image is kept.
+    pge::trace::Scope scope("textures::decode");
+
+    Cache& c = cache();
+
+    auto img = std::make_shared<olc::Sprite>(file);
+    if (img->pColData == nullptr || img->width <= 0 || img->height <= 0) {
+      PGE_LOG_AS(utils::Level::Error, "textures", "loader", "Failed to load image \"", file, "\"");
+
+      const std::lock_guard guard(c.lock);
+      c.loading.erase(key);
+
+      return nullptr;
+    }
+
+    const std::lock_guard guard(c.lock);
+    c.loading.erase(key);
+
+    if (pge::ImageShPtr other = c.images[key].lock()) {
+      return other;
+    }
+
+    c.images[key] = img;
+    ++c.decoded;
+
+    return img;
+  }
+
+  void
+  work() {
+    Cache& c = cache();
+    std::unique_lock guard(c.lock);
+
+    while (true) {
+      c.wake.wait(guard, [&c] { return !c.running || !c.jobs.empty(); });
+
+      // The remaining jobs are done before exiting so
+      // that no request is left without an image.
+      if (c.jobs.empty()) {
+        return;
+      }
+
+      std::function<void()> job = std::move(c.jobs.front());
+      c.jobs.pop_front();
+      guard.unlock();
+
+      job();
+
+      guard.lock();
+    }
+  }
+
+}
+
+namespace pge {
+  namespace textures {
+
+    void
+    start(unsigned workers) {
+      Cache& c = cache();
+      const std::lock_guard guard(c.lock);
+
+      if (c.running) {
+        return;
+      }
+
+      c.running = true;
+      for (unsigned id = 0u ; id < std::max(workers, 1u) ; ++id) {
+        c.workers.emplace_back(work);
+      }
+    }
+
+    void
+    stop() {
+      Cache& c = cache();
+
+      {
+        const std::lock_guard guard(c.lock);
+        if (!c.running) {
+          return;
+        }
+
+        c.running = false;
+      }
+
+      c.wake.notify_all();
+      for (std::thread& worker : c.workers) {
+        worker.join();
+      }
+
+      c.workers.clear();
+    }
+
+    ImageFuture
+    request(const std::string& file) {
+      const std::string key = canonical(file);
+      Cache& c = cache();
+
+      std::promise<ImageShPtr> result;
+
+      {
+        std::unique_lock guard(c.lock);
+
+        if (ImageShPtr img = c.images[key].lock()) {
+          result.set_value(img);
+          return result.get_future().share();
+        }
+
+        const auto it = c.loading.find(key);
+        if (it != c.loading.end()) {
+          return it->second;
+        }
+
+        if (c.running) {
+          auto task = std::make_shared<std::packaged_task<ImageShPtr()>>(
+            [key, file] {
+              return decode(key, file);
+            }
+          );
+
+          ImageFuture image = task->get_future().share();
+          c.loading[key] = image;
+          c.jobs.push_back([task] { (*task)(); });
+          guard.unlock();
+
+          c.wake.notify_one();
+          return image;
+        }
+      }
+
+      result.set_value(decode(key, file));
+
+      return result.get_future().share();
+    }
+
+    void
+    schedule(std::function<void()> job) {
+      Cache& c = cache();
+
+      {
+        std::unique_lock guard(c.lock);
+        if (c.running) {
+          c.jobs.push_back(std::move(job));
+          guard.unlock();
+
+          c.wake.notify_one();
+          return;
+        }
+      }
+
+      job();
+    }
+
+    bool
+    ready(const ImageFuture& image) {
+      return image.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    ImageShPtr
+    image(const std::string& file) {
+      return request(file).get();
+    }
+
+    TextureShPtr
+    texture(const std::string& file) {
+      const std::string key = canonical(file);
+      Cache& c = cache();
+
+      {
+        const std::lock_guard guard(c.lock);
+        if (TextureShPtr tex = c.textures[key].lock()) {
+          return tex;
+        }
+      }
+
+      // The decal does not modify the image: the texture
+      // keeps the image alive until it is released.
+      TextureShPtr tex;
+      ImageFuture image = request(file);
+
+      if (ready(image)) {
+        ImageShPtr img = image.get();
+        if (img == nullptr) {
+          return nullptr;
+        }
+
+        tex = TextureShPtr(new olc::Decal(const_cast<olc::Sprite*>(img.get())), Release{img});
+      }
+      else {
+        tex = TextureShPtr(new olc::Decal(placeholderImage()), Release{nullptr});
+        c.uploads.push_back(Upload{tex, image});
+      }
+
+      const std::lock_guard guard(c.lock);
+      c.textures[key] = tex;
+
+      return tex;
+    }
+
+    TextureShPtr
+    placeholder() {
+      Cache& c = cache();
+
+      const std::lock_guard guard(c.lock);
+      if (TextureShPtr tex = c.placeholder.lock()) {
+        return tex;
+      }
+
+      TextureShPtr tex(new olc::Decal(placeholderImage()), Release{nullptr});
+      c.placeholder = tex;
+
+      return tex;
+    }
+
+    bool
+    pending(const TextureShPtr& tex) noexcept {
+      return tex != nullptr && tex->sprite == placeholderImage();
+    }
+
+    unsigned
+    upload(std::size_t budget) {
+      Cache& c = cache();
+      if (c.uploads.empty()) {
+        return 0u;
+      }
+
+      trace::Scope scope("textures::upload");
+
+      // Textures released or failing to load are dropped
+      // and the ones still decoding wait for a next call.
+      std::size_t spent = 0u;
+      unsigned count = 0u;
+
+      auto it = c.uploads.begin();
+      while (it != c.uploads.end()) {
+        TextureShPtr tex = it->texture.lock();
+        if (tex == nullptr) {
+          it = c.uploads.erase(it);
+          continue;
+        }
+
+        if (!ready(it->image)) {
+          ++it;
+          continue;
+        }
+
+        ImageShPtr img = it->image.get();
+        if (img == nullptr) {
+          it = c.uploads.erase(it);
+          continue;
+        }
+
+        const std::size_t bytes = sizeof(olc::Pixel) * img->width * img->height;
+        if (count > 0u && spent + bytes > budget) {
+          break;
+        }
+
+        std::get_deleter<Release>(tex)->image = img;
+        tex->sprite = const_cast<olc::Sprite*>(img.get());
+        tex->Update();
+
+        spent += bytes;
+        ++count;
+
+        it = c.uploads.erase(it);
+      }
+
+      c.uploaded += count;
+
+      return count;
+    }
+
+    unsigned
+    uploaded() noexcept {
+      return cache().uploaded.load();
+    }
+
+    unsigned
+    decoded() noexcept {
+      Cache& c = cache();
+
+      const std::lock_guard guard(c.lock);
+      return c.decoded;
+    }
+
+  }
+}
@@ -0,0 +1,153 @@
+#ifndef    TEXTURES_HH
+# define   TEXTURES_HH
+
+# include <memory>
+# include <string>
+# include <future>
+# include <functional>
+# include <cstddef>
+# include "olcEngine.hh"
+
+namespace pge {
+
+  /// @brief - An image decoded from a file, shared by all its users.
+  using ImageShPtr = std::shared_ptr<const olc::Sprite>;
+
+  /// @brief - A texture created from an image file, shared by all its
+  /// users. It also keeps the image alive.
+  using TextureShPtr = std::shared_ptr<olc::Decal>;
+
+  /// @brief - An image being decoded in the background. It yields a
+  /// `null` image if the file cannot be loaded.
+  using ImageFuture = std::shared_future<ImageShPtr>;
+
+  namespace textures {
+
+    /**
+     * @brief - Start the threads decoding the images requested with
+     *          `request` and `texture` in the background. Until then,
+     *          and after `stop`, images are decoded right away by the
+     *          thread requesting them.
+     * @param workers - the number of decoding threads.
+     */
+    void
+    start(unsigned workers = 2u);
+
+    /**
+     * @brief - Finish the images and jobs already requested and stop the
+     *          threads started by `start`.
+     */
+    void
+    stop();
+
+    /**
+     * @brief - Request the image stored in the input file, without
+     *          waiting for it to be decoded. Requesting an image which
+     *          is already in use or being decoded does not decode it
+     *          again.
+     * @param file - the path to the image.
+     * @return - the image, available once decoded.
+     */
+    ImageFuture
+    request(const std::string& file);
+
+    /**
+     * @brief - Run a job on the decoding threads, after the images
+     *          and jobs already requested. This allows to process the
+     *          decoded images in the background as well. When the
+     *          threads are not started the job is run right away.
+     * @param job - the job to run.
+     */
+    void
+    schedule(std::function<void()> job);
+
+    /**
+     * @brief - Whether the requested image is decoded, in which case
+     *          getting it does not block.
+     * @param image - the requested image.
+     * @return - `true` if the image is available.
+     */
+    bool
+    ready(const ImageFuture& image);
+
+    /**
+     * @brief - Return the image stored in the input file. Each file
+     *          is decoded once: while the image is used, requesting
+     *          it again returns the same object. Files are identified
+     *          by their canonical path, so that different paths to the
+     *          same file are shared as well. The image is released when
+     *          its last user goes away. This waits for the image to be
+     *          decoded.
+     * @param file - the path to the image.
+     * @return - the image or `null` if the file cannot be loaded.
+     */
+    ImageShPtr
+    image(const std::string& file);
+
+    /**
+     * @brief - Similar to `image` but returns a texture holding the
+     *          image, which is also shared by all its users. It must
+     *          be created on the render thread and released before the
+     *          engine is destroyed. When the image is decoded in the
+     *          background the texture is returned right away with the
+     *          content of `placeholder`: the image is swapped in by a
+     *          later call to `upload`.
+     * @param file - the path to the image.
+     * @return - the texture or `null` if the file cannot be loaded.
+     */
+    TextureShPtr
+    texture(const std::string& file);
+
+    /**
+     * @brief - A texture drawn in place of the images which are not
+     *          available yet. It is a single translucent grey texel.
+     *          Like `texture` it is shared by all its users.
+     * @return - the placeholder texture.
+     */
+    TextureShPtr
+    placeholder();
+
+    /**
+     * @brief - Whether the texture still shows the placeholder because
+     *          its image is not uploaded yet. Failing to load the file
+     *          leaves the placeholder for good.
+     * @param tex - the texture to check.
+     * @return - `true` if the texture is waiting for its image.
+     */
+    bool
+    pending(const TextureShPtr& tex) noexcept;
+
+    /**
+     * @brief - Send the images decoded since the last call to their
+     *          textures. This should be called on the render thread
+     *          once per frame: images are uploaded in the order they
+     *          were requested until the budget is spent. At least one
+     *          image is uploaded so that images larger than the budget
+     *          still appear.
+     * @param budget - the number of bytes which can be uploaded.
+     * @return - the number of textures updated.
+     */
+    unsigned
+    upload(std::size_t budget);
+
+    /**
+     * @brief - The number of textures updated by `upload` since the
+     *          start of the app. It allows to detect that some users
+     *          should refresh what they draw.
+     * @return - the number of uploaded textures.
+     */
+    unsigned
+    uploaded() noexcept;
+
+    /**
+     * @brief - The number of files decoded since the start of the app,
+     *          which only increases when a file is not already in use.
+     * @return - the number of decoded files.
+     */
+    unsigned
+    decoded() noexcept;
+
+  }
+}
+
+#endif    /* TEXTURES_HH */
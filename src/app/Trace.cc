@@ -0,0 +1,142 @@
+
+# include "Trace.hh"
+# include <mutex>
+# include <chrono>
+# include <memory>
+# include <vector>
+# include <fstream>
+# include <limits>
+# include <iomanip>
+# include <algorithm>
+
+namespace {
+
+  /// @brief - The buffers of all the threads which recorded events. They
+  /// are kept after the threads exit so that their events can be saved.
+  /// The registry also keeps a reference point to convert the time of
+  /// the events to nanoseconds (see `trace::now`).
+  struct Registry {
+    std::mutex lock;
+    std::vector<std::unique_ptr<pge::trace::ThreadBuffer>> buffers;
+
+    bool calibrated = false;
+    std::uint64_t ticks = 0u;
+    std::chrono::steady_clock::time_point time;
+  };
+
+  Registry&
+  registry() {
+    static Registry r;
+    return r;
+  }
+
+  std::string
+  escape(const char* str) {
+    std::string out;
+    for (const char* c = str ; *c != '\0' ; ++c) {
+      if (*c == '"' || *c == '\\') {
+        out += '\\';
+      }
+      out += *c;
+    }
+
+    return out;
+  }
+
+}
+
+namespace pge {
+  namespace trace {
+
+    namespace details {
+
+      ThreadBuffer*
+      create() {
+        Registry& r = registry();
+        const std::lock_guard guard(r.lock);
+
+        r.buffers.push_back(std::make_unique<ThreadBuffer>(r.buffers.size() + 1u));
+        return r.buffers.back().get();
+      }
+
+    }
+
+    ThreadBuffer::ThreadBuffer(unsigned tid) noexcept:
+      m_tid(tid),
+      m_count(0u),
+      m_events()
+    {}
+
+    void
+    enable(bool enabled) noexcept {
+      if (enabled) {
+        Registry& r = registry();
+        const std::lock_guard guard(r.lock);
+
+        if (!r.calibrated) {
+          r.calibrated = true;
+          r.ticks = now();
+          r.time = std::chrono::steady_clock::now();
+        }
+      }
+
+      details::recording.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool
+    save(const std::string& file) {
+      std::ofstream out(file);
+      if (!out.good()) {
+        return false;
+      }
+
+      Registry& r = registry();
+      const std::lock_guard guard(r.lock);
+
+      // Deduce the duration of a tick from the time
+      // elapsed since the recording was enabled.
+      double nsPerTick = 1.0;
+      const std::uint64_t ticks = now();
+      if (r.calibrated && ticks > r.ticks) {
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - r.time;
+        nsPerTick = elapsed.count() / (ticks - r.ticks);
+      }
+
+      // Times are expressed relatively to the first
+      // event to keep them readable.
+      std::uint64_t origin = std::numeric_limits<std::uint64_t>::max();
+      for (const auto& b : r.buffers) {
+        b->visit(
+          [&origin](const Event& e) {
+            origin = std::min(origin, e.begin);
+          }
+        );
+      }
+
+      out << std::fixed << std::setprecision(3);
+      out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+      bool first = true;
+      for (const auto& b : r.buffers) {
+        const unsigned tid = b->tid();
+
+        b->visit(
+          [&](const Event& e) {
+            // Complete events with times in microseconds.
+            out << (first ? "\n" : ",\n")
+                << "{\"name\":\"" << escape(e.name) << "\","
+                << "\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ","
+                << "\"ts\":" << (e.begin - origin) * nsPerTick / 1000.0 << ","
+                << "\"dur\":" << (e.end - e.begin) * nsPerTick / 1000.0 << "}";
+            first = false;
+          }
+        );
+      }
+
+      out << "\n]}\n";
+
+      return out.good();
+    }
+
+  }
+}
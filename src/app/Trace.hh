@@ -0,0 +1,162 @@
+#ifndef    TRACE_HH
+# define   TRACE_HH
+
+# include <array>
+# include <atomic>
+# include <chrono>
+# include <string>
+# include <cstdint>
+
+namespace pge {
+  namespace trace {
+
+    /// @brief - A scope recorded in the trace: its name and the time
+    /// at which it started and ended (see `now`).
+    struct Event {
+      const char* name;
+      std::uint64_t begin;
+      std::uint64_t end;
+    };
+
+    /// @brief - The events recorded by a single thread. Only the thread
+    /// owning the buffer writes in it so recording does not need any
+    /// lock: the position of the next event is published atomically so
+    /// that the events can be read while the thread is still running.
+    /// Once full, the oldest events are overwritten.
+    class ThreadBuffer {
+      public:
+
+        /**
+         * @brief - The number of events kept for each thread.
+         */
+        static constexpr unsigned Capacity = 1u << 16;
+
+        /**
+         * @brief - Create a new empty buffer.
+         * @param tid - the identifier of the thread in the trace.
+         */
+        ThreadBuffer(unsigned tid) noexcept;
+
+        /**
+         * @brief - Add a new event to the buffer.
+         * @param name - the name of the scope.
+         * @param begin - the start time.
+         * @param end - the end time.
+         */
+        void
+        push(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+        /**
+         * @brief - The identifier of the thread in the trace.
+         * @return - the identifier of the thread.
+         */
+        unsigned
+        tid() const noexcept;
+
+        /**
+         * @brief - Call the input process on each event still available
+         *          in the buffer, from the oldest to the most recent.
+         *          Events overwritten while being read are skipped.
+         * @param process - the process to call on each event.
+         */
+        template <typename Process>
+        void
+        visit(Process process) const;
+
+      private:
+
+        unsigned m_tid;
+
+        /**
+         * @brief - The total number of events pushed in the buffer. The
+         *          index of the next event is this count modulo the size
+         *          of the buffer.
+         */
+        std::atomic<std::uint64_t> m_count;
+
+        std::array<Event, Capacity> m_events;
+    };
+
+    /**
+     * @brief - Enable or disable the recording of events. Recording is
+     *          disabled by default, in which case scopes do not even
+     *          read the time.
+     * @param enabled - `true` to record events.
+     */
+    void
+    enable(bool enabled) noexcept;
+
+    /**
+     * @brief - Whether the events are recorded.
+     * @return - `true` if events are recorded.
+     */
+    bool
+    enabled() noexcept;
+
+    /**
+     * @brief - Returns the current time as used for the events. On x86
+     *          it is the time stamp counter of the processor which is
+     *          much cheaper to read than the system clocks: it is only
+     *          converted to an actual duration when saving the trace.
+     *          Otherwise it is the time in nanoseconds.
+     * @return - the current time.
+     */
+    std::uint64_t
+    now() noexcept;
+
+    /**
+     * @brief - Record a scope for the calling thread if the recording is
+     *          enabled.
+     * @param name - the name of the scope. It should live until the trace
+     *               is saved (typically a string literal).
+     * @param begin - the start time (see `now`).
+     * @param end - the end time (see `now`).
+     */
+    void
+    record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+    /**
+     * @brief - Save the events recorded by all the threads as a trace in
+     *          the Chrome trace event format. It can be opened with the
+     *          `chrome://tracing` page or with Perfetto. The events are
+     *          kept so that the trace can be saved again later.
+     * @param file - the path of the trace to create.
+     * @return - `true` if the trace was written.
+     */
+    bool
+    save(const std::string& file);
+
+    /// @brief - Records the time spent in its scope as an event of the
+    /// trace.
+    class Scope {
+      public:
+
+        /**
+         * @brief - Start recording the scope.
+         * @param name - the name of the scope. It should live until the
+         *               trace is saved (typically a string literal).
+         */
+        explicit Scope(const char* name) noexcept;
+
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+
+        const char* m_name;
+
+        /**
+         * @brief - The start of the scope or `0` if the recording was
+         *          disabled when the scope started.
+         */
+        std::uint64_t m_begin;
+    };
+
+  }
+}
+
+# include "Trace.hxx"
+
+#endif    /* TRACE_HH */
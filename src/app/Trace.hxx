@@ -0,0 +1,117 @@
+#ifndef    TRACE_HXX
+# define   TRACE_HXX
+
+# include "Trace.hh"
+
+# if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+# endif
+
+namespace pge {
+  namespace trace {
+
+    namespace details {
+
+      /// @brief - Whether the events are recorded.
+      inline std::atomic<bool> recording{false};
+
+      /// @brief - The buffer of the calling thread, created when the
+      /// thread records its first event.
+      inline thread_local ThreadBuffer* buffer = nullptr;
+
+      /**
+       * @brief - Create and register the buffer of the calling thread.
+       * @return - the buffer of the calling thread.
+       */
+      ThreadBuffer*
+      create();
+
+    }
+
+    inline
+    void
+    ThreadBuffer::push(const char* name, std::uint64_t begin, std::uint64_t end) noexcept {
+      // Only this thread writes the count: the
+      // release store publishes the event.
+      const std::uint64_t count = m_count.load(std::memory_order_relaxed);
+      m_events[count % Capacity] = Event{name, begin, end};
+      m_count.store(count + 1u, std::memory_order_release);
+    }
+
+    inline
+    unsigned
+    ThreadBuffer::tid() const noexcept {
+      return m_tid;
+    }
+
+    template <typename Process>
+    inline
+    void
+    ThreadBuffer::visit(Process process) const {
+      const std::uint64_t count = m_count.load(std::memory_order_acquire);
+      const std::uint64_t first = (count > Capacity ? count - Capacity : 0u);
+
+      for (std::uint64_t id = first ; id < count ; ++id) {
+        const Event e = m_events[id % Capacity];
+
+        // The writer may have wrapped around while the
+        // event was read (including the slot it is about
+        // to write): in this case it is not valid.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t current = m_count.load(std::memory_order_relaxed);
+        if (current >= Capacity && id <= current - Capacity) {
+          continue;
+        }
+
+        process(e);
+      }
+    }
+
+    inline
+    bool
+    enabled() noexcept {
+      return details::recording.load(std::memory_order_relaxed);
+    }
+
+    inline
+    std::uint64_t
+    now() noexcept {
+# if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+# else
+      const auto t = std::chrono::steady_clock::now().time_since_epoch();
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+# endif
+    }
+
+    inline
+    void
+    record(const char* name, std::uint64_t begin, std::uint64_t end) noexcept {
+      if (!enabled()) {
+        return;
+      }
+
+      if (details::buffer == nullptr) {
+        details::buffer = details::create();
+      }
+
+      details::buffer->push(name, begin, end);
+    }
+
+    inline
+    Scope::Scope(const char* name) noexcept:
+      m_name(name),
+      m_begin(enabled() ? now() : 0u)
+    {}
+
+    inline
+    Scope::~Scope() {
+      if (m_begin != 0u) {
+        record(m_name, m_begin, now());
+      }
+    }
+
+  }
+}
+
+#endif    /* TRACE_HXX */
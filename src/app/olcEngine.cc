@@ -3,3 +3,25 @@
 // in a dedicated file to speed up compilation.
 # define OLC_PGE_APPLICATION
 # include "olcEngine.hh"
+# include "Headless.hh"
+
+namespace pge::headless {
+
+  // The systems used by the engine are declared
+  // `static` in its header: they can only be
+  // replaced from this translation unit.
+  Renderer*
+  install(olc::PixelGameEngine& pge) {
+    auto renderer = std::make_unique<Renderer>();
+    Renderer* out = renderer.get();
+
+    olc::platform = std::make_unique<Platform>(*out);
+    olc::renderer = std::move(renderer);
+
+    olc::platform->ptrPGE = &pge;
+    olc::renderer->ptrPGE = &pge;
+
+    return out;
+  }
+
+}
@@ -0,0 +1,79 @@
+
+# include "Affine.hh"
+
+# if defined(__AVX2__)
+#  include <immintrin.h>
+# elif defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
+namespace pge::coordinates {
+
+  void
+  apply(const Affine& a,
+        const float* xs,
+        const float* ys,
+        float* outX,
+        float* outY,
+        unsigned count) noexcept
+  {
+    unsigned id = 0u;
+
+    // Note that in each vectorized loop both inputs are
+    // loaded before any output is written: this allows
+    // the output arrays to alias the input ones.
+# if defined(__AVX2__)
+    const __m256 xx = _mm256_set1_ps(a.xx);
+    const __m256 xy = _mm256_set1_ps(a.xy);
+    const __m256 xt = _mm256_set1_ps(a.xt);
+    const __m256 yx = _mm256_set1_ps(a.yx);
+    const __m256 yy = _mm256_set1_ps(a.yy);
+    const __m256 yt = _mm256_set1_ps(a.yt);
+
+    for (; id + 8u <= count ; id += 8u) {
+      const __m256 x = _mm256_loadu_ps(xs + id);
+      const __m256 y = _mm256_loadu_ps(ys + id);
+
+#  if defined(__FMA__)
+      const __m256 px = _mm256_fmadd_ps(xx, x, _mm256_fmadd_ps(xy, y, xt));
+      const __m256 py = _mm256_fmadd_ps(yx, x, _mm256_fmadd_ps(yy, y, yt));
+#  else
+      const __m256 px = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xx, x), _mm256_mul_ps(xy, y)), xt);
+      const __m256 py = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(yx, x), _mm256_mul_ps(yy, y)), yt);
+#  endif
+
+      _mm256_storeu_ps(outX + id, px);
+      _mm256_storeu_ps(outY + id, py);
+    }
+# elif defined(__SSE2__)
+    const __m128 xx = _mm_set1_ps(a.xx);
+    const __m128 xy = _mm_set1_ps(a.xy);
+    const __m128 xt = _mm_set1_ps(a.xt);
+    const __m128 yx = _mm_set1_ps(a.yx);
+    const __m128 yy = _mm_set1_ps(a.yy);
+    const __m128 yt = _mm_set1_ps(a.yt);
+
+    for (; id + 4u <= count ; id += 4u) {
+      const __m128 x = _mm_loadu_ps(xs + id);
+      const __m128 y = _mm_loadu_ps(ys + id);
+
+      const __m128 px = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, x), _mm_mul_ps(xy, y)), xt);
+      const __m128 py = _mm_add_ps(_mm_add_ps(_mm_mul_ps(yx, x), _mm_mul_ps(yy, y)), yt);
+
+      _mm_storeu_ps(outX + id, px);
+      _mm_storeu_ps(outY + id, py);
+    }
+# endif
+
+    // Handle remaining elements (or all of them in case
+    // no vector instruction set is available).
+    for (; id < count ; ++id) {
+      const float x = xs[id];
+      const float y = ys[id];
+
+      outX[id] = a.xx * x + a.xy * y + a.xt;
+      outY[id] = a.yx * x + a.yy * y + a.yt;
+    }
+  }
+
+}
@@ -0,0 +1,117 @@
+#ifndef    AFFINE_HH
+# define   AFFINE_HH
+
+# include "olcEngine.hh"
+# include "Viewport.hh"
+
+namespace pge::coordinates {
+
+  /// @brief - Describes a 2D affine transform as a `2x3` matrix: the
+  /// first two columns hold the linear part and the last one holds
+  /// the translation. A point `(x, y)` is thus transformed into:
+  /// `(xx * x + xy * y + xt, yx * x + yy * y + yt)`.
+  struct Affine {
+    float xx;
+    float xy;
+    float xt;
+
+    float yx;
+    float yy;
+    float yt;
+  };
+
+  /// @brief - Creates the identity transform.
+  /// @return - the identity transform.
+  Affine
+  newIdentity() noexcept;
+
+  /// @brief - Creates a purely linear transform from the coefficients
+  /// of a `2x2` matrix.
+  /// @param xx - the coefficient at row `0` and column `0`.
+  /// @param xy - the coefficient at row `0` and column `1`.
+  /// @param yx - the coefficient at row `1` and column `0`.
+  /// @param yy - the coefficient at row `1` and column `1`.
+  /// @return - the corresponding transform.
+  Affine
+  newLinear(float xx, float xy, float yx, float yy) noexcept;
+
+  /// @brief - Creates the transform converting a position expressed
+  /// in the input viewport to normalized coordinates (i.e. in the
+  /// range `[0; 1]` when inside the viewport). The origin is set to
+  /// the bottom left corner of the viewport and each axis can be
+  /// inverted.
+  /// @param vp - the viewport to normalize against.
+  /// @param invertX - whether the `x` axis should be inverted.
+  /// @param invertY - whether the `y` axis should be inverted.
+  /// @return - the normalization transform.
+  Affine
+  newNormalization(const Viewport<float>& vp,
+                   bool invertX,
+                   bool invertY) noexcept;
+
+  /// @brief - Creates the transform converting normalized coordinates
+  /// back into the input viewport. This is the reverse operation of a
+  /// `newNormalization` with no inverted axis.
+  /// @param vp - the viewport to denormalize into.
+  /// @return - the denormalization transform.
+  Affine
+  newDenormalization(const Viewport<float>& vp) noexcept;
+
+  /// @brief - Composes both transforms: the output transform applies
+  /// `inner` first and then `outer`.
+  /// @param outer - the transform applied last.
+  /// @param inner - the transform applied first.
+  /// @return - the composed transform.
+  Affine
+  compose(const Affine& outer, const Affine& inner) noexcept;
+
+  /// @brief - Returns a transform equivalent to first translating the
+  /// input point by `(dx, dy)` and then applying `a`.
+  /// @param a - the transform to modify.
+  /// @param dx - the translation along the `x` axis.
+  /// @param dy - the translation along the `y` axis.
+  /// @return - the translated transform.
+  Affine
+  preTranslate(const Affine& a, float dx, float dy) noexcept;
+
+  /// @brief - Returns a transform equivalent to applying `a` and then
+  /// translating the output by `(dx, dy)`.
+  /// @param a - the transform to modify.
+  /// @param dx - the translation along the `x` axis.
+  /// @param dy - the translation along the `y` axis.
+  /// @return - the translated transform.
+  Affine
+  postTranslate(const Affine& a, float dx, float dy) noexcept;
+
+  /// @brief - Applies the transform to a single point.
+  /// @param a - the transform to apply.
+  /// @param x - the abscissa of the point.
+  /// @param y - the ordinate of the point.
+  /// @return - the transformed point.
+  olc::vf2d
+  apply(const Affine& a, float x, float y) noexcept;
+
+  /// @brief - Applies the transform to arrays of points laid out as a
+  /// structure of arrays. Depending on the instruction set available
+  /// at compile time the conversion is performed with `AVX2` or `SSE`
+  /// vectors, falling back to a scalar loop for the remaining points.
+  /// Output arrays can alias the input ones.
+  /// @param a - the transform to apply.
+  /// @param xs - the abscissa of the points.
+  /// @param ys - the ordinate of the points.
+  /// @param outX - output array for the abscissa of the points.
+  /// @param outY - output array for the ordinate of the points.
+  /// @param count - the number of points in the arrays.
+  void
+  apply(const Affine& a,
+        const float* xs,
+        const float* ys,
+        float* outX,
+        float* outY,
+        unsigned count) noexcept;
+
+}
+
+# include "Affine.hxx"
+
+#endif    /* AFFINE_HH */
@@ -0,0 +1,102 @@
+#ifndef    AFFINE_HXX
+# define   AFFINE_HXX
+
+# include "Affine.hh"
+
+namespace pge::coordinates {
+
+  inline
+  Affine
+  newIdentity() noexcept {
+    return newLinear(1.0f, 0.0f, 0.0f, 1.0f);
+  }
+
+  inline
+  Affine
+  newLinear(float xx, float xy, float yx, float yy) noexcept {
+    return Affine{
+      xx, xy, 0.0f,
+      yx, yy, 0.0f
+    };
+  }
+
+  inline
+  Affine
+  newNormalization(const Viewport<float>& vp,
+                   bool invertX,
+                   bool invertY) noexcept
+  {
+    const auto bl = vp.bottomLeft();
+    const auto& dims = vp.dims();
+
+    // Inverting an axis means computing `(bl - v) / dims`
+    // instead of `(v - bl) / dims`.
+    const float sx = (invertX ? -1.0f : 1.0f) / dims.x;
+    const float sy = (invertY ? -1.0f : 1.0f) / dims.y;
+
+    return Affine{
+      sx, 0.0f, -bl.x * sx,
+      0.0f, sy, -bl.y * sy
+    };
+  }
+
+  inline
+  Affine
+  newDenormalization(const Viewport<float>& vp) noexcept {
+    const auto bl = vp.bottomLeft();
+    const auto& dims = vp.dims();
+
+    return Affine{
+      dims.x, 0.0f, bl.x,
+      0.0f, dims.y, bl.y
+    };
+  }
+
+  inline
+  Affine
+  compose(const Affine& outer, const Affine& inner) noexcept {
+    return Affine{
+      outer.xx * inner.xx + outer.xy * inner.yx,
+      outer.xx * inner.xy + outer.xy * inner.yy,
+      outer.xx * inner.xt + outer.xy * inner.yt + outer.xt,
+
+      outer.yx * inner.xx + outer.yy * inner.yx,
+      outer.yx * inner.xy + outer.yy * inner.yy,
+      outer.yx * inner.xt + outer.yy * inner.yt + outer.yt
+    };
+  }
+
+  inline
+  Affine
+  preTranslate(const Affine& a, float dx, float dy) noexcept {
+    Affine out = a;
+
+    out.xt += a.xx * dx + a.xy * dy;
+    out.yt += a.yx * dx + a.yy * dy;
+
+    return out;
+  }
+
+  inline
+  Affine
+  postTranslate(const Affine& a, float dx, float dy) noexcept {
+    Affine out = a;
+
+    out.xt += dx;
+    out.yt += dy;
+
+    return out;
+  }
+
+  inline
+  olc::vf2d
+  apply(const Affine& a, float x, float y) noexcept {
+    return olc::vf2d(
+      a.xx * x + a.xy * y + a.xt,
+      a.yx * x + a.yy * y + a.yt
+    );
+  }
+
+}
+
+#endif    /* AFFINE_HXX */
@@ -1,9 +1,14 @@
 #ifndef    FRAME_HH
 # define   FRAME_HH
 
+# include <array>
 # include <memory>
+# include <cstdint>
 # include <core_utils/CoreObject.hh>
+# include <core_utils/Signal.hh>
 # include "Viewport.hh"
+# include "Affine.hh"
+# include "VisibleTiles.hh"
 
 namespace pge::coordinates {
 
@@ -19,6 +24,24 @@ namespace pge::coordinates {
     LeftCenter
   };
 
+  /// @brief - Defines the kind of modification applied to a frame. It
+  /// allows consumers to only invalidate what is needed: a translation
+  /// keeps the size of the tiles in pixels while a change of scale or a
+  /// replacement of the frame does not.
+  enum class FrameChange {
+    Pan,
+    Scale,
+    Replaced
+  };
+
+  /// @brief - Returns the offset of the location within a tile, as a
+  /// fraction of the size of the tile along each axis. The top left
+  /// corner corresponds to `(0, 0)` and the bottom right to `(1, 1)`.
+  /// @param location - the location within the tile.
+  /// @return - the offset of this location.
+  olc::vf2d
+  tileLocationOffset(const TileLocation& location) noexcept;
+
   class Frame: public utils::CoreObject {
     public:
       using IViewport = Viewport<float>;
@@ -28,6 +51,16 @@ namespace pge::coordinates {
 
       virtual ~Frame() = default;
 
+      /// @brief - Returns the current version of the frame. It changes
+      /// each time the frame is modified (through a zoom or a panning),
+      /// and versions are never shared between frames: consumers can
+      /// compare it with the version they used to compute cached data
+      /// to know whether it is still valid, even if the frame has been
+      /// replaced.
+      /// @return - the current version of the frame.
+      std::uint64_t
+      version() const noexcept;
+
       /// @brief - Returns the actual size of the tile by applying the
       /// current scaling factor (as returned by `tileScale`) to the
       /// initial tile size.
@@ -40,6 +73,15 @@ namespace pge::coordinates {
       IViewport
       cellsViewport() const noexcept;
 
+      /// @brief - Return the exact list of tiles visible on screen. The
+      /// four corners of the screen are converted to tiles so that it
+      /// stays accurate when the frame is rotated, which is not the case
+      /// of the `cellsViewport`.
+      /// @param resource - the memory to use for the list of tiles.
+      /// @return - the tiles visible on screen.
+      VisibleTiles
+      visibleTiles(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
       /// @brief - Used to convert from tile coordinates to pixel
       /// coordinates. This method can be used when some tile is to be
       /// displayed on the screen. We make use of a global position of
@@ -66,6 +108,59 @@ namespace pge::coordinates {
       tileCoordsToPixels(const olc::vf2d pos,
                          const TileLocation& location = TileLocation::TopLeft) const noexcept;
 
+      /// @brief - Batched version of `tileCoordsToPixels` converting
+      /// arrays of coordinates laid out as a structure of arrays. The
+      /// transform of the frame is evaluated once and then applied to
+      /// all the points with vector instructions, which is much faster
+      /// than converting each tile through a virtual call.
+      /// The output arrays can alias the input ones.
+      /// @param xs - the cells coordinates along the `x` axis.
+      /// @param ys - the cells coordinates along the `y` axis.
+      /// @param pxs - output array for the pixels coordinates along the
+      /// `x` axis. Should be able to hold at least `count` elements.
+      /// @param pys - output array for the pixels coordinates along the
+      /// `y` axis. Should be able to hold at least `count` elements.
+      /// @param count - the number of coordinates to convert.
+      /// @param location - the location within the tiles.
+      void
+      batchTileCoordsToPixels(const float* xs,
+                              const float* ys,
+                              float* pxs,
+                              float* pys,
+                              unsigned count,
+                              const TileLocation& location = TileLocation::TopLeft) const noexcept;
+
+      /// @brief - Interface method returning the affine transform which
+      /// converts tile coordinates to the pixel coordinates of the input
+      /// location within the tile. It is used by the batched conversion
+      /// and should be consistent with `tileCoordsToPixels`.
+      /// @param location - the location within the tile.
+      /// @return - the transform from tiles to pixels.
+      virtual Affine
+      tilesToPixelsTransform(const TileLocation& location) const noexcept = 0;
+
+      /// @brief - Describes how the corners of a tile are shared with its
+      /// neighbors: the corner of the tile `(x, y)` at `corner` is located
+      /// at the top left corner of the tile `(x + dx, y + dy)`, where the
+      /// output of this method is `(dx, dy)`. It allows to build a grid
+      /// of vertices shared by adjacent tiles.
+      /// The default implementation assumes that the bottom right corner
+      /// is the top left corner of the tile `(x + 1, y + 1)`.
+      /// @param corner - the corner of the tile: should be one of the
+      /// `TopLeft`, `TopRight`, `BottomRight` or `BottomLeft` values.
+      /// @return - the offset of the tile sharing this corner.
+      virtual olc::vi2d
+      cornerOffset(const TileLocation& corner) const noexcept;
+
+      /// @brief - Returns the four corners of the tile in pixels. The
+      /// order is the one expected by the `DrawWarpedDecal` method, i.e.
+      /// top left, bottom left, bottom right and top right. It is more
+      /// efficient than calling `tileCoordsToPixels` for each corner.
+      /// @param tile - the coordinates of the tile.
+      /// @return - the corners of the tile in pixels.
+      std::array<olc::vf2d, 4>
+      tileQuad(const olc::vi2d& tile) const noexcept;
+
       /// @brief - Convert from pixels coordinates to tile coords. Some
       /// extra logic is added in order to account for the tiles that do
       /// not align with the grid so that we always get an accurate
@@ -131,8 +226,28 @@ namespace pge::coordinates {
       void
       translate(const olc::vf2d& pos);
 
+    protected:
+
+      /// @brief - Interface method called whenever the viewports of the
+      /// frame are modified (through a zoom or a translation). It allows
+      /// inheriting classes to refresh any cached data computed from
+      /// them. The default implementation does nothing.
+      virtual void
+      onViewportsChanged();
+
     private:
 
+      /// @brief - Generate a new version, unique among all frames.
+      /// @return - a new version.
+      static std::uint64_t
+      nextVersion() noexcept;
+
+      /// @brief - Used to bump the version of the frame and notify the
+      /// listeners of the change.
+      /// @param change - the kind of change applied to the frame.
+      void
+      changed(const FrameChange& change);
+
       void
       updateScale();
 
@@ -179,6 +294,19 @@ namespace pge::coordinates {
       /// viewport when starting the translation. Once the translation is
       /// performed we are able to update the viewport accordingly.
       olc::vf2d m_cachedPOrigin;
+
+    private:
+
+      /// @brief - The current version of the frame.
+      std::uint64_t m_version;
+
+    public:
+
+      /// @brief - Signal emitted whenever the frame is modified, with
+      /// the kind of modification applied. Note that the `Replaced`
+      /// change is never emitted by the frame itself: it is up to the
+      /// owner of the frame to notify it.
+      utils::Signal<FrameChange> onChanged;
   };
 
   using FrameShPtr = std::shared_ptr<Frame>;
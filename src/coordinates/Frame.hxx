@@ -6,6 +6,24 @@
 
 namespace pge::coordinates {
 
+  inline
+  olc::vf2d
+  tileLocationOffset(const TileLocation& location) noexcept {
+    // Indexed by the values of the `TileLocation` enumeration.
+    static const olc::vf2d offsets[] = {
+      olc::vf2d(0.0f, 0.0f), // TopLeft
+      olc::vf2d(0.5f, 0.0f), // TopCenter
+      olc::vf2d(1.0f, 0.0f), // TopRight
+      olc::vf2d(1.0f, 0.5f), // RightCenter
+      olc::vf2d(1.0f, 1.0f), // BottomRight
+      olc::vf2d(0.5f, 1.0f), // BottomCenter
+      olc::vf2d(0.0f, 1.0f), // BottomLeft
+      olc::vf2d(0.0f, 0.5f)  // LeftCenter
+    };
+
+    return offsets[static_cast<int>(location)];
+  }
+
   inline
   Frame::Frame(const IViewport& tiles,
                const IViewport& pixels):
@@ -17,12 +35,22 @@ namespace pge::coordinates {
     m_tilesToPixelsScale(1.0f, 1.0f),
 
     m_translationOrigin(),
-    m_cachedPOrigin()
+    m_cachedPOrigin(),
+
+    m_version(nextVersion()),
+
+    onChanged()
   {
     setService("coordinate");
     updateScale();
   }
 
+  inline
+  std::uint64_t
+  Frame::version() const noexcept {
+    return m_version;
+  }
+
   inline
   olc::vf2d
   Frame::tilesToPixels() const noexcept {
@@ -50,16 +78,74 @@ namespace pge::coordinates {
     return out;
   }
 
+  inline
+  VisibleTiles
+  Frame::visibleTiles(std::pmr::memory_resource* resource) const {
+    const auto dims = m_pixels.dims();
+
+    const auto toTiles = [this](float px, float py) {
+      olc::vf2d intra;
+      const auto tile = pixelCoordsToTiles(px, py, &intra);
+      return olc::vf2d(tile.x + intra.x, tile.y + intra.y);
+    };
+
+    const std::array<olc::vf2d, 4> corners = {
+      toTiles(0.0f, 0.0f),
+      toTiles(dims.x, 0.0f),
+      toTiles(dims.x, dims.y),
+      toTiles(0.0f, dims.y)
+    };
+
+    return VisibleTiles(corners, resource);
+  }
+
   inline
   olc::vf2d
   Frame::tileCoordsToPixels(const olc::vf2d pos, const TileLocation& location) const noexcept {
     return tileCoordsToPixels(pos.x, pos.y, location);
   }
 
+  inline
+  void
+  Frame::batchTileCoordsToPixels(const float* xs,
+                                 const float* ys,
+                                 float* pxs,
+                                 float* pys,
+                                 unsigned count,
+                                 const TileLocation& location) const noexcept
+  {
+    apply(tilesToPixelsTransform(location), xs, ys, pxs, pys, count);
+  }
+
+  inline
+  olc::vi2d
+  Frame::cornerOffset(const TileLocation& corner) const noexcept {
+    const auto offset = tileLocationOffset(corner);
+    return olc::vi2d(static_cast<int>(offset.x), static_cast<int>(offset.y));
+  }
+
+  inline
+  std::array<olc::vf2d, 4>
+  Frame::tileQuad(const olc::vi2d& tile) const noexcept {
+    const auto transform = tilesToPixelsTransform(TileLocation::TopLeft);
+
+    const auto corner = [this, &transform, &tile](const TileLocation& location) {
+      const auto offset = cornerOffset(location);
+      return apply(transform, tile.x + offset.x, tile.y + offset.y);
+    };
+
+    return {
+      corner(TileLocation::TopLeft),
+      corner(TileLocation::BottomLeft),
+      corner(TileLocation::BottomRight),
+      corner(TileLocation::TopRight)
+    };
+  }
+
   inline
   olc::vi2d
   Frame::pixelCoordsToTiles(const olc::vf2d pos) const noexcept {
-    return pixelCoordsToTiles(pos);
+    return pixelCoordsToTiles(pos.x, pos.y);
   }
 
   inline
@@ -91,18 +177,53 @@ namespace pge::coordinates {
     // We need to deduce the translation added by the input `pos`
     // assuming that this will be the final position of the viewport.
     olc::vf2d translation = pos - m_translationOrigin;
-    m_pixels.move(m_cachedPOrigin + translation);
+    const olc::vf2d corner = m_cachedPOrigin + translation;
+
+    // The translation is requested on each frame while the
+    // button is held: the frame only changes when the mouse
+    // moved since the last one.
+    if (corner == m_pixels.primaryCorner()) {
+      return;
+    }
+
+    m_pixels.move(corner);
+
+    onViewportsChanged();
+    changed(FrameChange::Pan);
+  }
+
+  inline
+  void
+  Frame::onViewportsChanged() {}
+
+  inline
+  std::uint64_t
+  Frame::nextVersion() noexcept {
+    static std::uint64_t version = 0u;
+    return ++version;
+  }
+
+  inline
+  void
+  Frame::changed(const FrameChange& change) {
+    m_version = nextVersion();
+    onChanged.safeEmit("frame changed", change);
   }
 
   inline
   void
   Frame::updateScale() {
     m_tilesToPixelsScale = m_pixels.dims() / m_tiles.dims();
+    onViewportsChanged();
+    changed(FrameChange::Scale);
 
-    log(
-      "1 tile = " + m_tilesToPixelsScale.str() + " pixel(s)",
-      utils::Level::Debug
-    );
+    // The scale is not formatted with `str`: once inlined, its
+    // concatenations trip a spurious `-Wrestrict` in GCC 12.
+    std::string message("1 tile = (");
+    message.append(std::to_string(m_tilesToPixelsScale.x)).append(",");
+    message.append(std::to_string(m_tilesToPixelsScale.y)).append(") pixel(s)");
+
+    log(message, utils::Level::Debug);
   }
 
   inline
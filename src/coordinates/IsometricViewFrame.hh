@@ -6,7 +6,7 @@
 
 namespace pge::coordinates {
 
-  class IsometricViewFrame: public Frame {
+  class IsometricViewFrame final: public Frame {
     public:
 
       IsometricViewFrame(const IViewport& tiles,
@@ -14,6 +14,11 @@ namespace pge::coordinates {
 
       virtual ~IsometricViewFrame() = default;
 
+      // Keep the convenience overloads visible when the frame is used
+      // with its concrete type.
+      using Frame::tileCoordsToPixels;
+      using Frame::pixelCoordsToTiles;
+
       /// @brief - Implementation of the interface method.
       olc::vf2d
       tileCoordsToPixels(float cx,
@@ -26,21 +31,37 @@ namespace pge::coordinates {
                          float py,
                          olc::vf2d* intraTile = nullptr) const noexcept override;
 
+      /// @brief - Implementation of the interface method.
+      Affine
+      tilesToPixelsTransform(const TileLocation& location) const noexcept override;
+
+    protected:
+
+      /// @brief - Implementation of the interface method: refreshes the
+      /// cached transforms.
+      void
+      onViewportsChanged() override;
+
     private:
 
       /// @brief - Convenience Eigen defines.
       using Mat2f = Eigen::Matrix2f;
-      using Vec2f = Eigen::Vector2f;
 
       void
       generateMatrices();
 
-      olc::vf2d
-      coordinateFrameChange(const float x,
-                            bool invertX,
-                            const float y,
-                            bool invertY,
-                            const IViewport& source,
+      /// @brief - Folds the normalization against the source viewport,
+      /// the input transformation matrix and the denormalization in the
+      /// destination viewport into a single affine transform. The `y`
+      /// axis of the source viewport is inverted.
+      /// @param source - the viewport in which input coordinates are
+      /// expressed.
+      /// @param transform - the transformation matrix to apply.
+      /// @param dest - the viewport in which output coordinates will be
+      /// expressed.
+      /// @return - the corresponding transform.
+      Affine
+      coordinateFrameChange(const IViewport& source,
                             const Mat2f& transform,
                             const IViewport& dest) const noexcept;
 
@@ -54,6 +75,14 @@ namespace pge::coordinates {
       /// world coordinate space to the pixel coordinate space. This is
       /// the inverse matrix of the previous one.
       Mat2f m_worldToPixMat;
+
+      /// @brief - The cached transform from tile coordinates to pixels.
+      /// Refreshed each time the viewports change.
+      Affine m_tilesToPixels;
+
+      /// @brief - The cached transform from pixel coordinates to tiles.
+      /// Refreshed each time the viewports change.
+      Affine m_pixelsToTiles;
   };
 
 }
@@ -12,9 +12,16 @@ namespace pge::coordinates {
                                          const IViewport& pixels):
     Frame(tiles, pixels),
 
-    m_pixToWorldMat(Mat2f::Identity())
+    m_pixToWorldMat(Mat2f::Identity()),
+    m_worldToPixMat(Mat2f::Identity()),
+
+    m_tilesToPixels(newIdentity()),
+    m_pixelsToTiles(newIdentity())
   {
     generateMatrices();
+
+    // The base class can't notify us during its construction.
+    onViewportsChanged();
   }
 
   inline
@@ -23,32 +30,8 @@ namespace pge::coordinates {
                                          float cy,
                                          const TileLocation& location) const noexcept
   {
-    switch (location) {
-      case TileLocation::TopCenter:
-        return tileCoordsToPixels(cx + 0.5f, cy);
-      case TileLocation::TopRight:
-        return tileCoordsToPixels(cx + 1.0f, cy);
-      case TileLocation::RightCenter:
-        return tileCoordsToPixels(cx + 1.0f, cy + 0.5f);
-      case TileLocation::BottomRight:
-        return tileCoordsToPixels(cx + 1.0f, cy + 1.0f);
-      case TileLocation::BottomCenter:
-        return tileCoordsToPixels(cx + 0.5f, cy + 1.0f);
-      case TileLocation::BottomLeft:
-        return tileCoordsToPixels(cx, cy + 1.0f);
-      case TileLocation::LeftCenter:
-        return tileCoordsToPixels(cx, cy + 0.5f);
-      case TileLocation::TopLeft:
-      default:
-        break;
-    }
-
-    auto out = coordinateFrameChange(cx, false, cy, true, m_tiles, m_worldToPixMat, m_pixels);
-    // The offset accounts for the fact that the bottom tile is visible.
-    // If we don't do that the effective viewport is in fact:
-    // [m_tiles.bottomLeft().y + 1; m_tiles.topRight()] when it should be
-    // [m_tiles.bottomLeft().y; m_tiles.topRight() - 1].
-    return olc::vf2d{out.x, out.y};
+    const auto offset = tileLocationOffset(location);
+    return apply(m_tilesToPixels, cx + offset.x, cy + offset.y);
   }
 
   inline
@@ -57,7 +40,7 @@ namespace pge::coordinates {
                                          float py,
                                          olc::vf2d* intraTile) const noexcept
   {
-    const auto tiles = coordinateFrameChange(px, false, py, true, m_pixels, m_pixToWorldMat, m_tiles);
+    const auto tiles = apply(m_pixelsToTiles, px, py);
     const auto out = olc::vi2d{
       static_cast<int>(std::floor(tiles.x)),
       static_cast<int>(std::floor(tiles.y))
@@ -71,6 +54,22 @@ namespace pge::coordinates {
     return out;
   }
 
+  inline
+  Affine
+  IsometricViewFrame::tilesToPixelsTransform(const TileLocation& location) const noexcept {
+    // The location within the tile is an offset in tiles.
+    const auto offset = tileLocationOffset(location);
+    return preTranslate(m_tilesToPixels, offset.x, offset.y);
+  }
+
+  inline
+  void
+  IsometricViewFrame::onViewportsChanged() {
+    m_tilesToPixels = coordinateFrameChange(m_tiles, m_worldToPixMat, m_pixels);
+    m_pixelsToTiles = coordinateFrameChange(m_pixels, m_pixToWorldMat, m_tiles);
+  }
+
+  inline
   void
   IsometricViewFrame::generateMatrices() {
     // See this link:
@@ -93,48 +92,23 @@ namespace pge::coordinates {
   }
 
   inline
-  olc::vf2d
-  IsometricViewFrame::coordinateFrameChange(const float x,
-                                            bool invertX,
-                                            const float y,
-                                            bool invertY,
-                                            const IViewport& source,
+  Affine
+  IsometricViewFrame::coordinateFrameChange(const IViewport& source,
                                             const Mat2f& transform,
                                             const IViewport& dest) const noexcept
   {
-    // Convert to normalized coordinate space from the source.
-    auto tx = x;
-    if (invertX) {
-      tx = source.bottomLeft().x - tx;
-    }
-    else {
-      tx -= source.bottomLeft().x;
-    }
-    tx /= source.dims().x;
-
-    auto ty = y;
-    if (invertY) {
-      ty = source.bottomLeft().y - ty;
-    }
-    else {
-      ty -= source.bottomLeft().y;
-    }
-    ty /= source.dims().y;
-
-    // Apply the coordinate frame transform.
-    Vec2f v(tx, ty);
-    Vec2f tr = transform * v;
-    tx = tr(0);
-    ty = tr(1);
-
-    // Convert back to the destination viewport.
-    tx *= dest.dims().x;
-    tx += dest.bottomLeft().x;
-
-    ty *= dest.dims().y;
-    ty += dest.bottomLeft().y;
-
-    return olc::vf2d(tx, ty);
+    // Convert to normalized coordinate space from the source,
+    // apply the coordinate frame transform and convert back
+    // to the destination viewport.
+    const auto linear = newLinear(
+      transform(0, 0), transform(0, 1),
+      transform(1, 0), transform(1, 1)
+    );
+
+    return compose(
+      newDenormalization(dest),
+      compose(linear, newNormalization(source, false, true))
+    );
   }
 
 }
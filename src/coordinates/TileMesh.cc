@@ -0,0 +1,80 @@
+
+# include "TileMesh.hh"
+# include <algorithm>
+
+namespace pge::coordinates {
+
+  TileMesh::TileMesh():
+    m_valid(false),
+    m_version(0u),
+
+    m_min(),
+    m_max(),
+
+    m_corners(),
+
+    m_origin(),
+    m_width(0),
+
+    m_xs(),
+    m_ys()
+  {}
+
+  bool
+  TileMesh::update(const Frame& frame,
+                   const olc::vi2d& min,
+                   const olc::vi2d& max)
+  {
+    // The version of the frame changes with each zoom or
+    // panning, and is different for a replaced frame.
+    if (m_valid && frame.version() == m_version && min == m_min && max == m_max) {
+      return false;
+    }
+
+    m_valid = true;
+    m_version = frame.version();
+    m_min = min;
+    m_max = max;
+
+    // Same order as the quads.
+    m_corners = {
+      frame.cornerOffset(TileLocation::TopLeft),
+      frame.cornerOffset(TileLocation::BottomLeft),
+      frame.cornerOffset(TileLocation::BottomRight),
+      frame.cornerOffset(TileLocation::TopRight)
+    };
+    const auto& corners = m_corners;
+
+    // The lattice needs to cover the corners of all
+    // the tiles of the area.
+    olc::vi2d lo = corners[0];
+    olc::vi2d hi = corners[0];
+    for (unsigned id = 1u ; id < corners.size() ; ++id) {
+      lo.x = std::min(lo.x, corners[id].x);
+      lo.y = std::min(lo.y, corners[id].y);
+      hi.x = std::max(hi.x, corners[id].x);
+      hi.y = std::max(hi.y, corners[id].y);
+    }
+
+    m_origin = m_min + lo;
+    m_width = m_max.x + hi.x - m_origin.x + 1;
+    const int height = m_max.y + hi.y - m_origin.y + 1;
+
+    const unsigned count = m_width * height;
+    m_xs.resize(count);
+    m_ys.resize(count);
+
+    for (int y = 0 ; y < height ; ++y) {
+      for (int x = 0 ; x < m_width ; ++x) {
+        m_xs[y * m_width + x] = m_origin.x + x;
+        m_ys[y * m_width + x] = m_origin.y + y;
+      }
+    }
+
+    // Convert all the vertices in place in a single pass.
+    frame.batchTileCoordsToPixels(m_xs.data(), m_ys.data(), m_xs.data(), m_ys.data(), count);
+
+    return true;
+  }
+
+}
@@ -0,0 +1,91 @@
+#ifndef    TILE_MESH_HH
+# define   TILE_MESH_HH
+
+# include <array>
+# include <cstdint>
+# include <vector>
+# include "Frame.hh"
+
+namespace pge::coordinates {
+
+  /// @brief - A grid of vertices in pixels covering a rectangular area
+  /// of tiles. Adjacent tiles share their corners so each vertex of the
+  /// lattice is converted only once: an area of `W x H` tiles requires
+  /// `(W + 1) x (H + 1)` conversions instead of `4 x W x H` when each
+  /// corner is converted individually.
+  /// The vertices are only recomputed when the area or the version of
+  /// the frame change.
+  class TileMesh {
+    public:
+
+      TileMesh();
+
+      /// @brief - Update the mesh so that it covers the input area with
+      /// the current state of the frame. Nothing is recomputed if the
+      /// area and the frame did not change since the last update.
+      /// @param frame - the frame to use to convert tiles to pixels.
+      /// @param min - the tile with the smallest coordinates to cover.
+      /// @param max - the tile with the largest coordinates to cover.
+      /// @return - `true` if the vertices have been recomputed.
+      bool
+      update(const Frame& frame,
+             const olc::vi2d& min,
+             const olc::vi2d& max);
+
+      /// @brief - Whether the input tile is covered by the mesh.
+      /// @param tile - the tile to check.
+      /// @return - `true` if the quad of this tile is available.
+      bool
+      contains(const olc::vi2d& tile) const noexcept;
+
+      /// @brief - Return the quad representing the tile in pixels. The
+      /// order of the vertices is the one expected by `DrawWarpedDecal`
+      /// (see `Frame::tileQuad`). The tile is assumed to be covered by
+      /// the mesh.
+      /// @param tile - the tile for which the quad should be returned.
+      /// @return - the corners of the tile in pixels.
+      std::array<olc::vf2d, 4>
+      quad(const olc::vi2d& tile) const noexcept;
+
+      /// @brief - Return the number of vertices in the mesh.
+      /// @return - the number of vertices.
+      unsigned
+      vertices() const noexcept;
+
+    private:
+
+      olc::vf2d
+      vertex(int x, int y) const noexcept;
+
+    private:
+
+      /// @brief - Whether the vertices have been computed at least once.
+      bool m_valid;
+
+      /// @brief - The version of the frame used to compute the vertices.
+      std::uint64_t m_version;
+
+      /// @brief - The area of tiles covered by the mesh (both included).
+      olc::vi2d m_min;
+      olc::vi2d m_max;
+
+      /// @brief - The offsets of the corners of a tile in the lattice,
+      /// in the order of the quads (see `Frame::cornerOffset`).
+      std::array<olc::vi2d, 4> m_corners;
+
+      /// @brief - The lattice point corresponding to the first vertex
+      /// and the number of vertices in a row of the lattice.
+      olc::vi2d m_origin;
+      int m_width;
+
+      /// @brief - The coordinates of the vertices in pixels, stored row
+      /// by row.
+      std::vector<float> m_xs;
+      std::vector<float> m_ys;
+  };
+
+}
+
+# include "TileMesh.hxx"
+
+#endif    /* TILE_MESH_HH */
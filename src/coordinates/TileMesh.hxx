@@ -0,0 +1,44 @@
+#ifndef    TILE_MESH_HXX
+# define   TILE_MESH_HXX
+
+# include "TileMesh.hh"
+
+namespace pge::coordinates {
+
+  inline
+  bool
+  TileMesh::contains(const olc::vi2d& tile) const noexcept {
+    return
+      m_valid &&
+      tile.x >= m_min.x && tile.x <= m_max.x &&
+      tile.y >= m_min.y && tile.y <= m_max.y
+    ;
+  }
+
+  inline
+  std::array<olc::vf2d, 4>
+  TileMesh::quad(const olc::vi2d& tile) const noexcept {
+    return {
+      vertex(tile.x + m_corners[0].x, tile.y + m_corners[0].y),
+      vertex(tile.x + m_corners[1].x, tile.y + m_corners[1].y),
+      vertex(tile.x + m_corners[2].x, tile.y + m_corners[2].y),
+      vertex(tile.x + m_corners[3].x, tile.y + m_corners[3].y)
+    };
+  }
+
+  inline
+  unsigned
+  TileMesh::vertices() const noexcept {
+    return m_xs.size();
+  }
+
+  inline
+  olc::vf2d
+  TileMesh::vertex(int x, int y) const noexcept {
+    const int id = (y - m_origin.y) * m_width + (x - m_origin.x);
+    return olc::vf2d(m_xs[id], m_ys[id]);
+  }
+
+}
+
+#endif    /* TILE_MESH_HXX */
@@ -5,7 +5,7 @@
 
 namespace pge::coordinates {
 
-  class TopViewFrame: public Frame {
+  class TopViewFrame final: public Frame {
     public:
 
       TopViewFrame(const IViewport& tiles,
@@ -13,12 +13,26 @@ namespace pge::coordinates {
 
       virtual ~TopViewFrame() = default;
 
+      // Keep the convenience overloads visible when the frame is used
+      // with its concrete type.
+      using Frame::tileCoordsToPixels;
+      using Frame::pixelCoordsToTiles;
+
       /// @brief - Implementation of the interface method.
       olc::vf2d
       tileCoordsToPixels(float cx,
                          float cy,
                          const TileLocation& location = TileLocation::TopLeft) const noexcept override;
 
+      /// @brief - Implementation of the interface method.
+      Affine
+      tilesToPixelsTransform(const TileLocation& location) const noexcept override;
+
+      /// @brief - Implementation of the interface method: the ordinates
+      /// of tiles increase towards the top of the screen.
+      olc::vi2d
+      cornerOffset(const TileLocation& corner) const noexcept override;
+
       /// @brief - Implementation of the interface method.
       olc::vi2d
       pixelCoordsToTiles(float px,
@@ -66,6 +66,58 @@ namespace pge::coordinates {
     return out;
   }
 
+  inline
+  olc::vi2d
+  TopViewFrame::cornerOffset(const TileLocation& corner) const noexcept {
+    // The bottom row of the tile is the top row of the
+    // tile right below it, which has a lower ordinate.
+    switch (corner) {
+      case TileLocation::TopRight:
+        return olc::vi2d(1, 0);
+      case TileLocation::BottomRight:
+        return olc::vi2d(1, -1);
+      case TileLocation::BottomLeft:
+        return olc::vi2d(0, -1);
+      case TileLocation::TopLeft:
+      default:
+        return olc::vi2d(0, 0);
+    }
+  }
+
+  inline
+  Affine
+  TopViewFrame::tilesToPixelsTransform(const TileLocation& location) const noexcept {
+    // Same process as in `tileCoordsToPixels` but expressed
+    // as a transform: the location within the tile becomes
+    // an offset in pixels.
+    auto out = compose(
+      newDenormalization(m_pixels),
+      newNormalization(m_tiles, false, true)
+    );
+    out = postTranslate(out, 0.0f, -m_tilesToPixelsScale.y);
+
+    olc::vf2d ttp = tilesToPixels();
+    switch (location) {
+      case TileLocation::TopCenter:
+        return postTranslate(out, ttp.x / 2.0f, 0.0f);
+      case TileLocation::TopRight:
+        return postTranslate(out, ttp.x, 0.0f);
+      case TileLocation::RightCenter:
+        return postTranslate(out, ttp.x, ttp.y / 2.0f);
+      case TileLocation::BottomRight:
+        return postTranslate(out, ttp.x, ttp.y);
+      case TileLocation::BottomCenter:
+        return postTranslate(out, ttp.x / 2.0f, ttp.y);
+      case TileLocation::BottomLeft:
+        return postTranslate(out, 0.0f, ttp.y);
+      case TileLocation::LeftCenter:
+        return postTranslate(out, 0.0f, ttp.y / 2.0f);
+      case TileLocation::TopLeft:
+      default:
+        return out;
+    }
+  }
+
   inline
   olc::vf2d
   TopViewFrame::coordinateFrameChange(const float x,
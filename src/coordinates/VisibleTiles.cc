@@ -0,0 +1,81 @@
+
+# include "VisibleTiles.hh"
+# include <cmath>
+# include <limits>
+# include <algorithm>
+
+namespace pge::coordinates {
+
+  void
+  VisibleTiles::scanConvert(const std::array<olc::vf2d, 4>& corners) {
+    float yMin = corners[0].y;
+    float yMax = corners[0].y;
+    for (unsigned id = 1u ; id < corners.size() ; ++id) {
+      yMin = std::min(yMin, corners[id].y);
+      yMax = std::max(yMax, corners[id].y);
+    }
+
+    const int rMin = static_cast<int>(std::floor(yMin));
+    const int rMax = static_cast<int>(std::floor(yMax));
+
+    m_spans.reserve(rMax - rMin + 1);
+
+    // The row `y` covers the band `[y; y + 1]` in tiles:
+    // as the quad is convex, its intersection with the
+    // band is also convex and its vertices are either
+    // corners of the quad or intersections of the edges
+    // with the borders of the band. So clipping each
+    // edge to the band gives the extent of the row.
+    for (int y = rMin ; y <= rMax ; ++y) {
+      const float b0 = y;
+      const float b1 = y + 1.0f;
+
+      float xMin = std::numeric_limits<float>::max();
+      float xMax = std::numeric_limits<float>::lowest();
+
+      for (unsigned id = 0u ; id < corners.size() ; ++id) {
+        const olc::vf2d& p0 = corners[id];
+        const olc::vf2d& p1 = corners[(id + 1u) % corners.size()];
+
+        const float eMin = std::min(p0.y, p1.y);
+        const float eMax = std::max(p0.y, p1.y);
+        if (eMax < b0 || eMin > b1) {
+          continue;
+        }
+
+        // Horizontal edges (or degenerated ones) are
+        // fully inside the band at this point.
+        if (eMax - eMin <= std::numeric_limits<float>::epsilon()) {
+          xMin = std::min(xMin, std::min(p0.x, p1.x));
+          xMax = std::max(xMax, std::max(p0.x, p1.x));
+          continue;
+        }
+
+        const float slope = (p1.x - p0.x) / (p1.y - p0.y);
+
+        const float c0 = std::max(eMin, b0);
+        const float c1 = std::min(eMax, b1);
+
+        const float x0 = p0.x + (c0 - p0.y) * slope;
+        const float x1 = p0.x + (c1 - p0.y) * slope;
+
+        xMin = std::min(xMin, std::min(x0, x1));
+        xMax = std::max(xMax, std::max(x0, x1));
+      }
+
+      if (xMin > xMax) {
+        continue;
+      }
+
+      TileSpan s{
+        y,
+        static_cast<int>(std::floor(xMin)),
+        static_cast<int>(std::floor(xMax))
+      };
+
+      m_spans.push_back(s);
+      m_count += static_cast<unsigned>(s.xMax - s.xMin + 1);
+    }
+  }
+
+}
@@ -0,0 +1,118 @@
+#ifndef    VISIBLE_TILES_HH
+# define   VISIBLE_TILES_HH
+
+# include <array>
+# include <vector>
+# include <memory_resource>
+# include <iterator>
+# include "olcEngine.hh"
+
+namespace pge::coordinates {
+
+  /// @brief - Defines the visible tiles on a single row: all the tiles
+  /// with an abscissa in the range `[xMin; xMax]` (both included) are
+  /// visible for this row.
+  struct TileSpan {
+    int y;
+    int xMin;
+    int xMax;
+  };
+
+  /// @brief - Exact list of tiles visible through the screen, computed
+  /// from the projection of the four corners of the screen in tiles
+  /// space. The resulting convex quadrilateral is scan-converted into
+  /// spans: unlike an axis aligned box this is exact for any rotation
+  /// of the frame.
+  /// Tiles can either be processed row by row through the `spans` or
+  /// one by one by iterating over this object.
+  class VisibleTiles {
+    public:
+
+      /// @brief - Forward iterator over the visible tiles.
+      class const_iterator {
+        public:
+
+          using iterator_category = std::forward_iterator_tag;
+          using value_type = olc::vi2d;
+          using difference_type = std::ptrdiff_t;
+          using pointer = const olc::vi2d*;
+          using reference = const olc::vi2d&;
+
+          const_iterator(const std::pmr::vector<TileSpan>& spans,
+                         unsigned span) noexcept;
+
+          reference
+          operator*() const noexcept;
+
+          pointer
+          operator->() const noexcept;
+
+          const_iterator&
+          operator++() noexcept;
+
+          const_iterator
+          operator++(int) noexcept;
+
+          bool
+          operator==(const const_iterator& rhs) const noexcept;
+
+          bool
+          operator!=(const const_iterator& rhs) const noexcept;
+
+        private:
+
+          /// @brief - The spans iterated upon.
+          const std::pmr::vector<TileSpan>* m_spans;
+
+          /// @brief - The index of the current span.
+          unsigned m_span;
+
+          /// @brief - The current tile.
+          olc::vi2d m_tile;
+      };
+
+      /// @brief - Compute the visible tiles from the quadrilateral in
+      /// input. The corners should be expressed in tiles and define a
+      /// convex shape, in any winding order.
+      /// @param corners - the corners of the visible area in tiles.
+      /// @param resource - the memory used for the spans, as the arena
+      /// of the frame when the tiles are only needed for a frame.
+      VisibleTiles(const std::array<olc::vf2d, 4>& corners,
+                   std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+      /// @brief - Return the visible tiles for each row, sorted by
+      /// ascending ordinate. Rows without visible tiles are omitted.
+      /// @return - the list of spans.
+      const std::pmr::vector<TileSpan>&
+      spans() const noexcept;
+
+      /// @brief - Return the total number of visible tiles.
+      /// @return - the number of visible tiles.
+      unsigned
+      count() const noexcept;
+
+      const_iterator
+      begin() const noexcept;
+
+      const_iterator
+      end() const noexcept;
+
+    private:
+
+      void
+      scanConvert(const std::array<olc::vf2d, 4>& corners);
+
+    private:
+
+      /// @brief - The visible tiles for each row.
+      std::pmr::vector<TileSpan> m_spans;
+
+      /// @brief - The total number of visible tiles.
+      unsigned m_count;
+  };
+
+}
+
+# include "VisibleTiles.hxx"
+
+#endif    /* VISIBLE_TILES_HH */
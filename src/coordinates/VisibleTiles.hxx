@@ -0,0 +1,106 @@
+#ifndef    VISIBLE_TILES_HXX
+# define   VISIBLE_TILES_HXX
+
+# include "VisibleTiles.hh"
+
+namespace pge::coordinates {
+
+  inline
+  VisibleTiles::const_iterator::const_iterator(const std::pmr::vector<TileSpan>& spans,
+                                               unsigned span) noexcept:
+    m_spans(&spans),
+    m_span(span),
+    m_tile()
+  {
+    if (m_span < m_spans->size()) {
+      m_tile = olc::vi2d((*m_spans)[m_span].xMin, (*m_spans)[m_span].y);
+    }
+  }
+
+  inline
+  VisibleTiles::const_iterator::reference
+  VisibleTiles::const_iterator::operator*() const noexcept {
+    return m_tile;
+  }
+
+  inline
+  VisibleTiles::const_iterator::pointer
+  VisibleTiles::const_iterator::operator->() const noexcept {
+    return &m_tile;
+  }
+
+  inline
+  VisibleTiles::const_iterator&
+  VisibleTiles::const_iterator::operator++() noexcept {
+    ++m_tile.x;
+    if (m_tile.x <= (*m_spans)[m_span].xMax) {
+      return *this;
+    }
+
+    // Move to the next row: the end iterator is
+    // defined with a default tile.
+    ++m_span;
+    m_tile = olc::vi2d();
+    if (m_span < m_spans->size()) {
+      m_tile = olc::vi2d((*m_spans)[m_span].xMin, (*m_spans)[m_span].y);
+    }
+
+    return *this;
+  }
+
+  inline
+  VisibleTiles::const_iterator
+  VisibleTiles::const_iterator::operator++(int) noexcept {
+    const_iterator out = *this;
+    ++(*this);
+    return out;
+  }
+
+  inline
+  bool
+  VisibleTiles::const_iterator::operator==(const const_iterator& rhs) const noexcept {
+    return m_spans == rhs.m_spans && m_span == rhs.m_span && m_tile == rhs.m_tile;
+  }
+
+  inline
+  bool
+  VisibleTiles::const_iterator::operator!=(const const_iterator& rhs) const noexcept {
+    return !operator==(rhs);
+  }
+
+  inline
+  VisibleTiles::VisibleTiles(const std::array<olc::vf2d, 4>& corners,
+                             std::pmr::memory_resource* resource):
+    m_spans(resource),
+    m_count(0u)
+  {
+    scanConvert(corners);
+  }
+
+  inline
+  const std::pmr::vector<TileSpan>&
+  VisibleTiles::spans() const noexcept {
+    return m_spans;
+  }
+
+  inline
+  unsigned
+  VisibleTiles::count() const noexcept {
+    return m_count;
+  }
+
+  inline
+  VisibleTiles::const_iterator
+  VisibleTiles::begin() const noexcept {
+    return const_iterator(m_spans, 0u);
+  }
+
+  inline
+  VisibleTiles::const_iterator
+  VisibleTiles::end() const noexcept {
+    return const_iterator(m_spans, m_spans.size());
+  }
+
+}
+
+#endif    /* VISIBLE_TILES_HXX */
@@ -0,0 +1,112 @@
+#ifndef    CHUNK_HH
+# define   CHUNK_HH
+
+# include <array>
+# include <cstdint>
+# include <memory>
+
+namespace pge {
+
+  /// @brief - The type of a tile in the world. The value `0` is reserved
+  /// for empty tiles.
+  using TileType = std::uint16_t;
+
+  /// @brief - The type of a tile where nothing is defined.
+  constexpr TileType EmptyTile = 0u;
+
+  /// @brief - A square block of tiles of the world. Chunks are only
+  /// allocated for the parts of the world where at least one tile is
+  /// not empty.
+  class Chunk {
+    public:
+
+      /**
+       * @brief - The number of tiles along each axis of a chunk. It
+       *          is a power of two so that the chunk of a tile and its
+       *          position in the chunk are obtained with bit operations.
+       */
+      static constexpr int SizeLog2 = 5;
+      static constexpr int Size = 1 << SizeLog2;
+      static constexpr int Mask = Size - 1;
+
+      /**
+       * @brief - Create a new chunk with only empty tiles.
+       */
+      Chunk() noexcept;
+
+      /**
+       * @brief - Return the type of the tile at the specified position
+       *          in the chunk.
+       * @param x - the abscissa of the tile in the chunk.
+       * @param y - the ordinate of the tile in the chunk.
+       * @return - the type of the tile.
+       */
+      TileType
+      at(int x, int y) const noexcept;
+
+      /**
+       * @brief - Define the type of the tile at the specified position
+       *          in the chunk.
+       * @param x - the abscissa of the tile in the chunk.
+       * @param y - the ordinate of the tile in the chunk.
+       * @param type - the new type of the tile.
+       */
+      void
+      set(int x, int y, TileType type) noexcept;
+
+      /**
+       * @brief - Return the revision of the chunk. It is assigned by the
+       *          world each time a tile of the chunk changes and allows
+       *          to detect whether data computed from the chunk is still
+       *          up to date.
+       * @return - the revision of the chunk.
+       */
+      std::uint64_t
+      revision() const noexcept;
+
+      /**
+       * @brief - Define a new revision for the chunk.
+       * @param revision - the new revision.
+       */
+      void
+      touch(std::uint64_t revision) noexcept;
+
+      /**
+       * @brief - Return the number of tiles of the chunk which are not
+       *          empty.
+       * @return - the number of non empty tiles.
+       */
+      unsigned
+      used() const noexcept;
+
+      /**
+       * @brief - Whether all the tiles of the chunk are empty.
+       * @return - `true` if the chunk only contains empty tiles.
+       */
+      bool
+      empty() const noexcept;
+
+    private:
+
+      /**
+       * @brief - The types of the tiles, stored row by row.
+       */
+      std::array<TileType, Size * Size> m_tiles;
+
+      /**
+       * @brief - The number of tiles which are not empty.
+       */
+      unsigned m_used;
+
+      /**
+       * @brief - The revision of the chunk.
+       */
+      std::uint64_t m_revision;
+  };
+
+  using ChunkPtr = std::unique_ptr<Chunk>;
+}
+
+# include "Chunk.hxx"
+
+#endif    /* CHUNK_HH */
@@ -0,0 +1,64 @@
+#ifndef    CHUNK_HXX
+# define   CHUNK_HXX
+
+# include "Chunk.hh"
+
+namespace pge {
+
+  inline
+  Chunk::Chunk() noexcept:
+    m_tiles(),
+    m_used(0u),
+    m_revision(0u)
+  {
+    m_tiles.fill(EmptyTile);
+  }
+
+  inline
+  TileType
+  Chunk::at(int x, int y) const noexcept {
+    return m_tiles[(y << SizeLog2) + x];
+  }
+
+  inline
+  void
+  Chunk::set(int x, int y, TileType type) noexcept {
+    TileType& t = m_tiles[(y << SizeLog2) + x];
+
+    if (t == EmptyTile && type != EmptyTile) {
+      ++m_used;
+    }
+    if (t != EmptyTile && type == EmptyTile) {
+      --m_used;
+    }
+
+    t = type;
+  }
+
+  inline
+  std::uint64_t
+  Chunk::revision() const noexcept {
+    return m_revision;
+  }
+
+  inline
+  void
+  Chunk::touch(std::uint64_t revision) noexcept {
+    m_revision = revision;
+  }
+
+  inline
+  unsigned
+  Chunk::used() const noexcept {
+    return m_used;
+  }
+
+  inline
+  bool
+  Chunk::empty() const noexcept {
+    return m_used == 0u;
+  }
+
+}
+
+#endif    /* CHUNK_HXX */
@@ -0,0 +1,67 @@
+
+# include "ChunkRenderCache.hh"
+
+namespace pge {
+
+  ChunkRenderCache::ChunkRenderCache(Palette palette):
+    m_palette(palette),
+
+    m_lists(),
+
+    m_mesh()
+  {}
+
+  void
+  ChunkRenderCache::invalidate() noexcept {
+    m_lists.clear();
+  }
+
+  void
+  ChunkRenderCache::build(ChunkRenderList& list,
+                          const Chunk& chunk,
+                          const coordinates::Frame& frame,
+                          const olc::vf2d& anchor)
+  {
+    list.revision = chunk.revision();
+    list.offsets.clear();
+    list.colors.clear();
+    list.offsets.reserve(4u * chunk.used());
+    list.colors.reserve(4u * chunk.used());
+
+    // The corners shared by adjacent tiles are only
+    // converted once for the whole chunk.
+    const olc::vi2d origin(list.cx * Chunk::Size, list.cy * Chunk::Size);
+    m_mesh.update(frame, origin, origin + olc::vi2d(Chunk::Size - 1, Chunk::Size - 1));
+
+    for (int y = 0 ; y < Chunk::Size ; ++y) {
+      for (int x = 0 ; x < Chunk::Size ; ++x) {
+        const TileType t = chunk.at(x, y);
+        if (t == EmptyTile) {
+          continue;
+        }
+
+        const olc::Pixel c = m_palette(t);
+
+        // Offsets are relative to the anchor so that the
+        // list stays valid when the frame is panned.
+        for (const auto& corner : m_mesh.quad(origin + olc::vi2d(x, y))) {
+          list.offsets.push_back(corner - anchor);
+          list.colors.push_back(c);
+        }
+      }
+    }
+  }
+
+  void
+  ChunkRenderCache::prune(const World& world) {
+    for (auto it = m_lists.begin() ; it != m_lists.end() ; ) {
+      if (world.chunk(it->second.cx, it->second.cy) == nullptr) {
+        it = m_lists.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
+}
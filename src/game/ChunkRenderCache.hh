@@ -0,0 +1,140 @@
+#ifndef    CHUNK_RENDER_CACHE_HH
+# define   CHUNK_RENDER_CACHE_HH
+
+# include <array>
+# include <vector>
+# include <cstdint>
+# include <unordered_map>
+# include <memory_resource>
+# include "olcEngine.hh"
+# include "Frame.hh"
+# include "TileMesh.hh"
+# include "World.hh"
+
+namespace pge {
+
+  /// @brief - The quads of the non empty tiles of a chunk, ready to be
+  /// drawn. Positions are expressed in pixels relatively to the anchor
+  /// of the chunk (the position of its first tile) so that they stay
+  /// valid when the frame is panned.
+  struct ChunkRenderList {
+    // The position of the chunk.
+    int cx;
+    int cy;
+
+    // The revision of the chunk used to build the list.
+    std::uint64_t revision;
+
+    // The corners of the quads, 4 per tile in the order expected by
+    // `DrawExplicitDecal` (see `Frame::tileQuad`).
+    std::vector<olc::vf2d> offsets;
+
+    // The color of each corner of the quads.
+    std::vector<olc::Pixel> colors;
+  };
+
+  /// @brief - Keeps the render lists of the chunks of a world. Chunks
+  /// are culled as a whole against the screen and their lists are only
+  /// rebuilt when one of their tiles changes or when the cache is
+  /// invalidated because the scale of the frame changed: drawing the
+  /// world is then a per-chunk rather than a per-tile work.
+  class ChunkRenderCache {
+    public:
+
+      /**
+       * @brief - Defines the color of a type of tile.
+       */
+      using Palette = olc::Pixel (*)(TileType);
+
+      /**
+       * @brief - Create a new empty cache.
+       * @param palette - the colors to use for the tiles.
+       */
+      ChunkRenderCache(Palette palette);
+
+      /**
+       * @brief - Discard all the render lists. This should be called
+       *          when the scale of the frame changes or when the frame
+       *          is replaced, but not when it is panned.
+       */
+      void
+      invalidate() noexcept;
+
+      /**
+       * @brief - Draw the chunks of the world which are visible on the
+       *          screen. The render lists of the chunks are updated if
+       *          needed before being forwarded to the drawing process.
+       * @param world - the world to draw.
+       * @param frame - the frame to use to convert tiles to pixels.
+       * @param screen - the area of the screen in pixels.
+       * @param scratch - the memory for the data only needed during
+       *                  this call, as the arena of the frame.
+       * @param draw - the process called with the render list of each
+       *               visible chunk and the position of its anchor in
+       *               pixels.
+       * @return - the number of chunks drawn.
+       */
+      template <typename Draw>
+      unsigned
+      render(const World& world,
+             const coordinates::Frame& frame,
+             const coordinates::ViewportF& screen,
+             std::pmr::memory_resource* scratch,
+             Draw draw);
+
+      /**
+       * @brief - Return the number of render lists in the cache.
+       * @return - the number of render lists.
+       */
+      unsigned
+      size() const noexcept;
+
+    private:
+
+      /**
+       * @brief - Generate the render list of a chunk from its tiles.
+       * @param list - the render list to fill.
+       * @param chunk - the chunk to represent.
+       * @param frame - the frame to use to convert tiles to pixels.
+       * @param anchor - the position of the first tile of the chunk
+       *                 in pixels.
+       */
+      void
+      build(ChunkRenderList& list,
+            const Chunk& chunk,
+            const coordinates::Frame& frame,
+            const olc::vf2d& anchor);
+
+      /**
+       * @brief - Remove the render lists of chunks that do not exist in
+       *          the world anymore.
+       * @param world - the world represented by the cache.
+       */
+      void
+      prune(const World& world);
+
+    private:
+
+      /**
+       * @brief - The colors of the tiles.
+       */
+      Palette m_palette;
+
+      /**
+       * @brief - The render lists indexed by the key of their chunk (see
+       *          `World::key`).
+       */
+      std::unordered_map<std::uint64_t, ChunkRenderList> m_lists;
+
+      /**
+       * @brief - The corners of the tiles of the chunk being built. It
+       *          is kept to avoid allocating it for each build.
+       */
+      coordinates::TileMesh m_mesh;
+  };
+
+}
+
+# include "ChunkRenderCache.hxx"
+
+#endif    /* CHUNK_RENDER_CACHE_HH */
@@ -0,0 +1,140 @@
+#ifndef    CHUNK_RENDER_CACHE_HXX
+# define   CHUNK_RENDER_CACHE_HXX
+
+# include "ChunkRenderCache.hh"
+# include <algorithm>
+
+namespace pge {
+
+  template <typename Draw>
+  inline
+  unsigned
+  ChunkRenderCache::render(const World& world,
+                           const coordinates::Frame& frame,
+                           const coordinates::ViewportF& screen,
+                           std::pmr::memory_resource* scratch,
+                           Draw draw)
+  {
+    const auto visible = frame.visibleTiles(scratch);
+    const auto& spans = visible.spans();
+    if (spans.empty()) {
+      return 0u;
+    }
+
+    // Only the chunks overlapping the visible
+    // tiles need to be considered.
+    int xMin = spans.front().xMin;
+    int xMax = spans.front().xMax;
+    for (const auto& span : spans) {
+      xMin = std::min(xMin, span.xMin);
+      xMax = std::max(xMax, span.xMax);
+    }
+
+    const int cxMin = World::chunkCoord(xMin);
+    const int cxMax = World::chunkCoord(xMax);
+    const int cyMin = World::chunkCoord(spans.front().y);
+    const int cyMax = World::chunkCoord(spans.back().y);
+
+    const auto transform = frame.tilesToPixelsTransform(coordinates::TileLocation::TopLeft);
+
+    // The tiles of a chunk cover the lattice of their
+    // corners (see `Frame::cornerOffset`): the area of
+    // the chunk on screen is bounded by the projection
+    // of the corners of this lattice.
+    olc::vi2d lo = frame.cornerOffset(coordinates::TileLocation::TopLeft);
+    olc::vi2d hi = lo;
+    for (const auto& location : {
+      coordinates::TileLocation::BottomLeft,
+      coordinates::TileLocation::BottomRight,
+      coordinates::TileLocation::TopRight
+    })
+    {
+      const olc::vi2d corner = frame.cornerOffset(location);
+      lo.x = std::min(lo.x, corner.x);
+      lo.y = std::min(lo.y, corner.y);
+      hi.x = std::max(hi.x, corner.x);
+      hi.y = std::max(hi.y, corner.y);
+    }
+    hi += olc::vi2d(Chunk::Size - 1, Chunk::Size - 1);
+
+    unsigned drawn = 0u;
+
+    for (int cy = cyMin ; cy <= cyMax ; ++cy) {
+      for (int cx = cxMin ; cx <= cxMax ; ++cx) {
+        const Chunk* chunk = world.chunk(cx, cy);
+        if (chunk == nullptr) {
+          continue;
+        }
+
+        // Chunks are culled before their render list is
+        // looked up, so that the lists of the chunks off
+        // screen are neither built nor updated. A list
+        // built earlier is still kept until the chunk is
+        // released from the world and the list pruned.
+        const float x0 = static_cast<float>(cx * Chunk::Size + lo.x);
+        const float y0 = static_cast<float>(cy * Chunk::Size + lo.y);
+        const float x1 = static_cast<float>(cx * Chunk::Size + hi.x);
+        const float y1 = static_cast<float>(cy * Chunk::Size + hi.y);
+
+        const std::array<olc::vf2d, 4> bounds = {
+          coordinates::apply(transform, x0, y0),
+          coordinates::apply(transform, x1, y0),
+          coordinates::apply(transform, x1, y1),
+          coordinates::apply(transform, x0, y1)
+        };
+
+        olc::vf2d min = bounds[0];
+        olc::vf2d max = bounds[0];
+        for (unsigned id = 1u ; id < bounds.size() ; ++id) {
+          min.x = std::min(min.x, bounds[id].x);
+          min.y = std::min(min.y, bounds[id].y);
+          max.x = std::max(max.x, bounds[id].x);
+          max.y = std::max(max.y, bounds[id].y);
+        }
+
+        if (!screen.visible((min + max) / 2.0f, (max - min) / 2.0f)) {
+          continue;
+        }
+
+        const auto anchor = coordinates::apply(
+          transform,
+          static_cast<float>(cx * Chunk::Size),
+          static_cast<float>(cy * Chunk::Size)
+        );
+
+        auto it = m_lists.find(World::key(cx, cy));
+        if (it == m_lists.end()) {
+          it = m_lists.emplace(World::key(cx, cy), ChunkRenderList{}).first;
+          it->second.cx = cx;
+          it->second.cy = cy;
+
+          build(it->second, *chunk, frame, anchor);
+        }
+        else if (it->second.revision != chunk->revision()) {
+          build(it->second, *chunk, frame, anchor);
+        }
+
+        draw(it->second, anchor);
+        ++drawn;
+      }
+    }
+
+    // Render lists of released chunks are not
+    // reached anymore: clean them from time to
+    // time.
+    if (m_lists.size() > 2u * world.chunks() + 64u) {
+      prune(world);
+    }
+
+    return drawn;
+  }
+
+  inline
+  unsigned
+  ChunkRenderCache::size() const noexcept {
+    return m_lists.size();
+  }
+
+}
+
+#endif    /* CHUNK_RENDER_CACHE_HXX */
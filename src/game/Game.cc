@@ -1,7 +1,18 @@
 
 # include "Game.hh"
 # include <cxxabi.h>
+# include <cmath>
 # include "Menu.hh"
+# include "Trace.hh"
+# include "Log.hh"
+
+namespace {
+
+  /// @brief - The type of tile created when the user performs an action
+  /// on the world.
+  constexpr pge::TileType TowerTile = 1u;
+
+}
 
 namespace pge {
 
@@ -16,9 +27,11 @@ namespace pge {
       }
     ),
 
-    m_menus()
+    m_menus(),
+
+    m_world()
   {
-    setService("game");
+    setService(LogService);
   }
 
   Game::~Game() {}
@@ -32,22 +45,35 @@ namespace pge {
   }
 
   void
-  Game::performAction(float /*x*/, float /*y*/) {
+  Game::performAction(float x, float y) {
     // Only handle actions when the game is not disabled.
     if (m_state.disabled) {
       log("Ignoring action while menu is disabled");
       return;
     }
+
+    const int tx = static_cast<int>(std::floor(x));
+    const int ty = static_cast<int>(std::floor(y));
+
+    // Only create a tower where nothing exists yet.
+    if (m_world.at(tx, ty) != EmptyTile) {
+      log("Ignoring action on occupied tile " + std::to_string(tx) + "x" + std::to_string(ty));
+      return;
+    }
+
+    m_world.set(tx, ty, TowerTile);
   }
 
   bool
   Game::step(float /*tDelta*/) {
+    trace::Scope scope("Game::step");
+
     // When the game is paused it is not over yet.
     if (m_state.paused) {
       return true;
     }
 
-    info("Perform step method of the game");
+    PGE_INFO("Perform step method of the game");
 
     updateUI();
 
@@ -80,7 +106,7 @@ namespace pge {
 
   void
   Game::updateUI() {
-    info("Perform update of UI menus");
+    PGE_INFO("Perform update of UI menus");
   }
 
   bool
@@ -105,10 +131,16 @@ namespace pge {
         olc::Pixel c = menu->getBackgroundColor();
 
         float d = utils::diffInMs(date, utils::now()) / duration;
-        c.a = static_cast<uint8_t>(
+        const auto alpha = static_cast<uint8_t>(
           std::clamp((1.0f - d) * pge::alpha::Opaque, 0.0f, 255.0f)
         );
-        menu->setBackground(pge::menu::newColoredBackground(c));
+
+        // Most frames do not change the alpha, so there
+        // is no need to update the background.
+        if (alpha != c.a) {
+          c.a = alpha;
+          menu->setBackground(pge::menu::newColoredBackground(c));
+        }
       }
     }
     // Or if the menu shouldn't be active anymore and
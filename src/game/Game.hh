@@ -5,6 +5,7 @@
 # include <memory>
 # include <core_utils/CoreObject.hh>
 # include <core_utils/TimeUtils.hh>
+# include "World.hh"
 
 namespace pge {
 
@@ -54,6 +55,13 @@ namespace pge {
       void
       performAction(float x, float y);
 
+      /**
+       * @brief - Returns the tiles of the world managed by the game.
+       * @return - the world of the game.
+       */
+      const World&
+      world() const noexcept;
+
       /**
        * @brief - Requests the game to be terminated. This is
        *          applied to the next iteration of the game
@@ -111,6 +119,12 @@ namespace pge {
 
     private:
 
+      /**
+       * @brief - The service of the messages of this class, given
+       *          to `setService` and to the logging macros.
+       */
+      static constexpr const char* LogService = "game";
+
       /**
        * @brief - Used to enable or disable the menus that
        *          compose the game. This allows to easily
@@ -195,6 +209,11 @@ namespace pge {
        *          current state of the simulation.
        */
       Menus m_menus;
+
+      /**
+       * @brief - The tiles of the world.
+       */
+      World m_world;
   };
 
   using GameShPtr = std::shared_ptr<Game>;
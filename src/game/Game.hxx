@@ -5,6 +5,12 @@
 
 namespace pge {
 
+  inline
+  const World&
+  Game::world() const noexcept {
+    return m_world;
+  }
+
   inline
   void
   Game::terminate() noexcept {
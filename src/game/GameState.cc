@@ -121,7 +121,7 @@ namespace pge {
 
   menu::InputHandle
   GameState::processUserInput(const controls::State& c,
-                              std::vector<ActionShPtr>& actions)
+                              ActionQueue& actions)
   {
     menu::InputHandle res{false, false};
 
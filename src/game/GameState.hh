@@ -76,7 +76,7 @@ namespace pge {
        */
       menu::InputHandle
       processUserInput(const controls::State& c,
-                       std::vector<ActionShPtr>& actions);
+                       ActionQueue& actions);
 
     private:
 
@@ -111,12 +111,16 @@ namespace pge {
       }
     );
 
-    // Register menu to the parent.
-    menu->addMenu(m_previous);
-    for (unsigned id = 0u ; id < m_games.size() ; ++id) {
-      menu->addMenu(m_games[id]);
-    }
-    menu->addMenu(m_next);
+    // Register menu to the parent: they are laid out
+    // once all of them are added.
+    std::vector<MenuShPtr> entries;
+    entries.reserve(m_games.size() + 2u);
+
+    entries.push_back(m_previous);
+    entries.insert(entries.end(), m_games.begin(), m_games.end());
+    entries.push_back(m_next);
+
+    menu->addMenus(entries);
   }
 
   void
@@ -0,0 +1,71 @@
+
+# include "World.hh"
+
+namespace {
+
+  /// @brief - A key which can't be generated for a chunk: the abscissa
+  /// of chunks is the one of the tiles divided by the size of a chunk,
+  /// so it never reaches `-2^31`.
+  constexpr std::uint64_t InvalidKey = std::uint64_t(1u) << 63;
+
+}
+
+namespace pge {
+
+  World::World():
+    m_chunks(),
+    m_tiles(0u),
+    m_revision(0u),
+
+    m_lastKey(InvalidKey),
+    m_last(nullptr)
+  {}
+
+  void
+  World::set(int x, int y, TileType type) {
+    const std::uint64_t k = key(chunkCoord(x), chunkCoord(y));
+    Chunk* c = find(k);
+
+    if (c == nullptr) {
+      // Empty tiles do not need a chunk.
+      if (type == EmptyTile) {
+        return;
+      }
+
+      auto chunk = std::make_unique<Chunk>();
+      c = chunk.get();
+      m_chunks.emplace(k, std::move(chunk));
+
+      m_last = c;
+    }
+
+    const int lx = localCoord(x);
+    const int ly = localCoord(y);
+    if (c->at(lx, ly) == type) {
+      return;
+    }
+
+    const unsigned used = c->used();
+    c->set(lx, ly, type);
+    c->touch(++m_revision);
+    m_tiles += c->used();
+    m_tiles -= used;
+
+    // Release the chunk when it does not hold
+    // any tile anymore.
+    if (c->empty()) {
+      m_chunks.erase(k);
+      m_last = nullptr;
+    }
+  }
+
+  void
+  World::clear() {
+    m_chunks.clear();
+    m_tiles = 0u;
+
+    m_lastKey = InvalidKey;
+    m_last = nullptr;
+  }
+
+}
@@ -0,0 +1,147 @@
+#ifndef    WORLD_HH
+# define   WORLD_HH
+
+# include <cstdint>
+# include <memory>
+# include <unordered_map>
+# include "Chunk.hh"
+
+namespace pge {
+
+  /// @brief - The storage for the tiles of the world. Tiles are grouped
+  /// in chunks (see `Chunk`) which are allocated when a tile becomes not
+  /// empty and released when all their tiles are empty again: the size
+  /// of the world is not bounded and empty regions do not cost memory.
+  /// Accessing a tile requires a single lookup of its chunk in a hash
+  /// table, and consecutive accesses to the same chunk even avoid it.
+  class World {
+    public:
+
+      /**
+       * @brief - Create a new empty world.
+       */
+      World();
+
+      /**
+       * @brief - Return the type of the tile at the specified position.
+       *          Tiles which were never defined are empty.
+       * @param x - the abscissa of the tile.
+       * @param y - the ordinate of the tile.
+       * @return - the type of the tile.
+       */
+      TileType
+      at(int x, int y) const noexcept;
+
+      /**
+       * @brief - Define the type of the tile at the specified position.
+       *          The chunk holding the tile is created or released if
+       *          needed.
+       * @param x - the abscissa of the tile.
+       * @param y - the ordinate of the tile.
+       * @param type - the new type of the tile.
+       */
+      void
+      set(int x, int y, TileType type);
+
+      /**
+       * @brief - Return the chunk at the specified position if it is
+       *          allocated. Chunk coordinates are the ones of the tiles
+       *          divided by the size of a chunk (see `chunkCoord`).
+       * @param cx - the abscissa of the chunk.
+       * @param cy - the ordinate of the chunk.
+       * @return - the chunk or `nullptr` if it only has empty tiles.
+       */
+      const Chunk*
+      chunk(int cx, int cy) const noexcept;
+
+      /**
+       * @brief - Return the number of chunks currently allocated.
+       * @return - the number of chunks.
+       */
+      unsigned
+      chunks() const noexcept;
+
+      /**
+       * @brief - Return the number of tiles which are not empty.
+       * @return - the number of non empty tiles.
+       */
+      std::uint64_t
+      tiles() const noexcept;
+
+      /**
+       * @brief - Release all the chunks of the world.
+       */
+      void
+      clear();
+
+      /**
+       * @brief - Generate a key identifying the chunk at the input
+       *          position. Keys are unique for each chunk.
+       * @param cx - the abscissa of the chunk.
+       * @param cy - the ordinate of the chunk.
+       * @return - the key of the chunk.
+       */
+      static std::uint64_t
+      key(int cx, int cy) noexcept;
+
+      /**
+       * @brief - Convert the coordinate of a tile to the coordinate of
+       *          its chunk. This works for negative coordinates.
+       * @param v - the coordinate of the tile along an axis.
+       * @return - the coordinate of the chunk along this axis.
+       */
+      static int
+      chunkCoord(int v) noexcept;
+
+      /**
+       * @brief - Convert the coordinate of a tile to its coordinate in
+       *          its chunk.
+       * @param v - the coordinate of the tile along an axis.
+       * @return - the coordinate of the tile in its chunk.
+       */
+      static int
+      localCoord(int v) noexcept;
+
+    private:
+
+      /**
+       * @brief - Return the chunk with the specified key or `nullptr`
+       *          if it is not allocated. The last chunk accessed is
+       *          kept to avoid the lookup for neighbouring tiles.
+       * @param k - the key of the chunk.
+       * @return - the chunk.
+       */
+      Chunk*
+      find(std::uint64_t k) const noexcept;
+
+    private:
+
+      /**
+       * @brief - The allocated chunks, indexed by their key.
+       */
+      std::unordered_map<std::uint64_t, ChunkPtr> m_chunks;
+
+      /**
+       * @brief - The number of tiles which are not empty.
+       */
+      std::uint64_t m_tiles;
+
+      /**
+       * @brief - The last revision assigned to a chunk. Revisions are
+       *          never reused, even when a chunk is released.
+       */
+      std::uint64_t m_revision;
+
+      /**
+       * @brief - The key and the chunk of the last lookup. The chunk
+       *          can be `nullptr` if it was not allocated.
+       */
+      mutable std::uint64_t m_lastKey;
+      mutable Chunk* m_last;
+  };
+
+}
+
+# include "World.hxx"
+
+#endif    /* WORLD_HH */
@@ -0,0 +1,76 @@
+#ifndef    WORLD_HXX
+# define   WORLD_HXX
+
+# include "World.hh"
+
+namespace pge {
+
+  inline
+  TileType
+  World::at(int x, int y) const noexcept {
+    const Chunk* c = find(key(chunkCoord(x), chunkCoord(y)));
+    if (c == nullptr) {
+      return EmptyTile;
+    }
+
+    return c->at(localCoord(x), localCoord(y));
+  }
+
+  inline
+  const Chunk*
+  World::chunk(int cx, int cy) const noexcept {
+    return find(key(cx, cy));
+  }
+
+  inline
+  unsigned
+  World::chunks() const noexcept {
+    return m_chunks.size();
+  }
+
+  inline
+  std::uint64_t
+  World::tiles() const noexcept {
+    return m_tiles;
+  }
+
+  inline
+  int
+  World::chunkCoord(int v) noexcept {
+    // Arithmetic shift rounds towards negative infinity.
+    return v >> Chunk::SizeLog2;
+  }
+
+  inline
+  int
+  World::localCoord(int v) noexcept {
+    return v & Chunk::Mask;
+  }
+
+  inline
+  std::uint64_t
+  World::key(int cx, int cy) noexcept {
+    return
+      (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+      static_cast<std::uint64_t>(static_cast<std::uint32_t>(cy))
+    ;
+  }
+
+  inline
+  Chunk*
+  World::find(std::uint64_t k) const noexcept {
+    if (k == m_lastKey) {
+      return m_last;
+    }
+
+    const auto it = m_chunks.find(k);
+
+    m_lastKey = k;
+    m_last = (it == m_chunks.cend() ? nullptr : it->second.get());
+
+    return m_last;
+  }
+
+}
+
+#endif    /* WORLD_HXX */
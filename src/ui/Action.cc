@@ -3,25 +3,10 @@
 
 namespace pge {
 
-  Action::Action(const action::Process& cb,
-                 const std::string& name):
-    utils::CoreObject(name),
+  Action::Action() noexcept:
+    m_ops(nullptr),
 
-    m_callback(cb)
-  {
-    setService("action");
-  }
-
-  Action::~Action() {}
-
-  void
-  Action::apply(Game& g) const {
-    m_callback(g);
-  }
-
-  void
-  Action::setProcess(const action::Process& cb) {
-    m_callback = cb;
-  }
+    m_storage()
+  {}
 
 }
@@ -1,8 +1,9 @@
 #ifndef    ACTION_HH
 # define   ACTION_HH
 
-# include <memory>
-# include <core_utils/CoreObject.hh>
+# include <array>
+# include <cstddef>
+# include <type_traits>
 # include "Game.hh"
 
 namespace pge {
@@ -11,68 +12,93 @@ namespace pge {
   // the actions will be applied.
   class Game;
 
-  namespace action {
-
-    /**
-     * @brief - Defines a common function called whenever
-     *          the action is triggered. This allows to
-     *          specialize the menu class easily when not
-     *          much is needed.
-     */
-    using Process = std::function<void(Game& g)>;
-
-  }
-
-  class Action: public utils::CoreObject {
+  /// @brief - A process applied to the game in response to an input
+  /// of the user. The process is any callable accepting a `Game&`: it
+  /// is stored inline in the action so that creating and moving it
+  /// never allocates. Processes larger than the storage are rejected
+  /// at compile time: they should capture a pointer to their state
+  /// rather than the state itself. Actions can't be copied: what needs
+  /// to trigger the same process several times should keep the action
+  /// and push a process referring to it instead.
+  class Action {
     public:
 
       /**
-       * @brief - Create a new empty action.
-       * @param name - the name of the action (for logging purposes).
+       * @brief - The size available to store the process.
        */
-      Action(const action::Process& cb,
-             const std::string& name = "action");
+      static constexpr std::size_t Storage = 48u;
 
       /**
-       * @brief - Desctruction of the object.
+       * @brief - Create a new empty action, doing nothing when it
+       *          is applied.
        */
-      virtual ~Action();
+      Action() noexcept;
 
       /**
-       * @brief - Interface method allowing to perform an
-       *          action. Nothing is known of the actual
-       *          process performed by the action and we
-       *          don't need to.
-       *          The goal is to provide a base interface
-       *          allowing menus to trigger some changes
-       *          in the game.
-       *          Inheriting classes should redefine this
-       *          method based on their effect.
-       * @param g - the game onto which the action should
-       *            be applied.
+       * @brief - Create a new action from the input process.
+       * @param process - the callable triggered when the action is
+       *                  applied.
        */
-      virtual void
-      apply(Game& g) const;
+      template <typename Process,
+                typename = std::enable_if_t<!std::is_same_v<std::decay_t<Process>, Action>>>
+      Action(Process&& process);
+
+      Action(const Action& rhs) = delete;
+
+      Action(Action&& rhs) noexcept;
+
+      Action&
+      operator=(const Action& rhs) = delete;
+
+      Action&
+      operator=(Action&& rhs) noexcept;
+
+      ~Action();
 
       /**
-       * @brief - Assign a new process to be triggered in
-       *          case this action is applied.
-       * @param cb - the new process to trigger when this
-       *             action is applied.
+       * @brief - Whether this action holds a process.
+       * @return - `true` if applying the action does something.
+       */
+      explicit
+      operator bool() const noexcept;
+
+      /**
+       * @brief - Perform the process of the action on the game. The
+       *          goal is to allow menus to trigger some changes in
+       *          the game without knowing anything about it.
+       * @param g - the game onto which the action should be applied.
        */
       void
-      setProcess(const action::Process& cb);
+      apply(Game& g) const;
 
     private:
 
       /**
-       * @brief - The callback to trigger when this action
-       *          is triggered.
+       * @brief - The operations performed on the stored process,
+       *          generated for each type of process.
        */
-      action::Process m_callback;
+      struct Operations {
+        void (*apply)(const void* process, Game& g);
+        void (*move)(void* from, void* to) noexcept;
+        void (*destroy)(void* process) noexcept;
+      };
+
+      template <typename Process>
+      static const Operations&
+      operations() noexcept;
+
+      void
+      reset() noexcept;
+
+    private:
+
+      const Operations* m_ops;
+
+      alignas(std::max_align_t) std::array<std::byte, Storage> m_storage;
   };
 
-  using ActionShPtr = std::shared_ptr<Action>;
 }
 
+# include "Action.hxx"
+
 #endif    /* ACTION_HH */
@@ -0,0 +1,109 @@
+#ifndef    ACTION_HXX
+# define   ACTION_HXX
+
+# include "Action.hh"
+# include <new>
+# include <utility>
+
+namespace pge {
+
+  template <typename Process, typename>
+  inline
+  Action::Action(Process&& process):
+    m_ops(&operations<std::decay_t<Process>>()),
+
+    m_storage()
+  {
+    using Stored = std::decay_t<Process>;
+
+    static_assert(sizeof(Stored) <= Storage, "Process of the action does not fit its storage");
+    static_assert(alignof(Stored) <= alignof(std::max_align_t), "Process of the action is over-aligned");
+    static_assert(std::is_nothrow_move_constructible_v<Stored>, "Process of the action should be nothrow movable");
+    static_assert(std::is_invocable_v<const Stored&, Game&>, "Process of the action should be callable when const");
+
+    new (m_storage.data()) Stored(std::forward<Process>(process));
+  }
+
+  inline
+  Action::Action(Action&& rhs) noexcept:
+    m_ops(rhs.m_ops),
+
+    m_storage()
+  {
+    if (m_ops != nullptr) {
+      m_ops->move(rhs.m_storage.data(), m_storage.data());
+      rhs.m_ops = nullptr;
+    }
+  }
+
+  inline
+  Action&
+  Action::operator=(Action&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+
+    reset();
+
+    m_ops = rhs.m_ops;
+    if (m_ops != nullptr) {
+      m_ops->move(rhs.m_storage.data(), m_storage.data());
+      rhs.m_ops = nullptr;
+    }
+
+    return *this;
+  }
+
+  inline
+  Action::~Action() {
+    reset();
+  }
+
+  inline
+  Action::operator bool() const noexcept {
+    return m_ops != nullptr;
+  }
+
+  inline
+  void
+  Action::apply(Game& g) const {
+    if (m_ops != nullptr) {
+      m_ops->apply(m_storage.data(), g);
+    }
+  }
+
+  template <typename Process>
+  inline
+  const Action::Operations&
+  Action::operations() noexcept {
+    // Moving leaves the source empty so that it can be
+    // destroyed right away.
+    static const Operations ops{
+      [](const void* process, Game& g) {
+        (*static_cast<const Process*>(process))(g);
+      },
+      [](void* from, void* to) noexcept {
+        Process* src = static_cast<Process*>(from);
+        new (to) Process(std::move(*src));
+        src->~Process();
+      },
+      [](void* process) noexcept {
+        static_cast<Process*>(process)->~Process();
+      }
+    };
+
+    return ops;
+  }
+
+  inline
+  void
+  Action::reset() noexcept {
+    if (m_ops != nullptr) {
+      m_ops->destroy(m_storage.data());
+      m_ops = nullptr;
+    }
+  }
+
+}
+
+#endif    /* ACTION_HXX */
@@ -0,0 +1,98 @@
+
+# include "ActionQueue.hh"
+
+namespace pge {
+
+  namespace {
+
+    std::uint64_t
+    roundCapacity(unsigned capacity) noexcept {
+      std::uint64_t c = 1u;
+      while (c < capacity) {
+        c <<= 1u;
+      }
+
+      return c;
+    }
+
+  }
+
+  ActionQueue::ActionQueue(unsigned capacity):
+    m_mask(roundCapacity(capacity) - 1u),
+    m_slots(std::make_unique<Action[]>(m_mask + 1u)),
+
+    m_head(0u),
+    m_cachedTail(0u),
+
+    m_tail(0u),
+    m_cachedHead(0u)
+  {}
+
+  unsigned
+  ActionQueue::capacity() const noexcept {
+    return static_cast<unsigned>(m_mask + 1u);
+  }
+
+  bool
+  ActionQueue::empty() const noexcept {
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+  }
+
+  bool
+  ActionQueue::push(Action&& action) noexcept {
+    const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    if (!reserve(tail)) {
+      return false;
+    }
+
+    m_slots[tail & m_mask] = std::move(action);
+    m_tail.store(tail + 1u, std::memory_order_release);
+
+    return true;
+  }
+
+  bool
+  ActionQueue::pop(Action& action) noexcept {
+    const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+
+    // Only read the index of the producer when all the
+    // actions known to be available were consumed.
+    if (head == m_cachedTail) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head == m_cachedTail) {
+        return false;
+      }
+    }
+
+    // Moving the action out leaves the slot empty: what
+    // the action captured is released by the consumer.
+    action = std::move(m_slots[head & m_mask]);
+    m_head.store(head + 1u, std::memory_order_release);
+
+    return true;
+  }
+
+  unsigned
+  ActionQueue::apply(Game& g) {
+    unsigned count = 0u;
+
+    Action action;
+    while (pop(action)) {
+      action.apply(g);
+      ++count;
+    }
+
+    return count;
+  }
+
+  bool
+  ActionQueue::reserve(std::uint64_t tail) noexcept {
+    if (tail - m_cachedHead <= m_mask) {
+      return true;
+    }
+
+    m_cachedHead = m_head.load(std::memory_order_acquire);
+    return tail - m_cachedHead <= m_mask;
+  }
+
+}
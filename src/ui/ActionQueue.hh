@@ -0,0 +1,127 @@
+#ifndef    ACTION_QUEUE_HH
+# define   ACTION_QUEUE_HH
+
+# include <atomic>
+# include <memory>
+# include <cstdint>
+# include "Action.hh"
+
+namespace pge {
+
+  /// @brief - A fixed-capacity queue of actions, produced by the menus
+  /// in response to the inputs and consumed by whoever applies them to
+  /// the game. The slots are allocated once when the queue is created:
+  /// pushing and popping only move the actions in and out of them.
+  /// The queue is safe to use with one producing thread and another
+  /// consuming thread, so that the actions could be applied by a thread
+  /// running the simulation.
+  class ActionQueue {
+    public:
+
+      /**
+       * @brief - The default number of actions which can be pending.
+       */
+      static constexpr unsigned DefaultCapacity = 256u;
+
+      /**
+       * @brief - Create a new empty queue.
+       * @param capacity - the maximum number of pending actions. It
+       *                   is rounded up to the next power of two.
+       */
+      explicit
+      ActionQueue(unsigned capacity = DefaultCapacity);
+
+      ActionQueue(const ActionQueue&) = delete;
+
+      ActionQueue&
+      operator=(const ActionQueue&) = delete;
+
+      /**
+       * @brief - The maximum number of pending actions.
+       * @return - the capacity of the queue.
+       */
+      unsigned
+      capacity() const noexcept;
+
+      /**
+       * @brief - Whether no action is pending. This is only a hint
+       *          when the other side of the queue is used at the
+       *          same time.
+       * @return - `true` if the queue is empty.
+       */
+      bool
+      empty() const noexcept;
+
+      /**
+       * @brief - Append an action to the queue. Should only be called
+       *          by the producing thread.
+       * @param action - the action to append.
+       * @return - `false` if the queue is full, in which case the
+       *           action is not queued.
+       */
+      bool
+      push(Action&& action) noexcept;
+
+      /**
+       * @brief - Extract the oldest pending action. Should only be
+       *          called by the consuming thread.
+       * @param action - output action, only assigned when an action
+       *                 is pending.
+       * @return - `true` if an action was extracted.
+       */
+      bool
+      pop(Action& action) noexcept;
+
+      /**
+       * @brief - Extract all the pending actions and apply them on
+       *          the game in the order they were pushed. Should only
+       *          be called by the consuming thread.
+       * @param g - the game onto which the actions are applied.
+       * @return - the number of actions applied.
+       */
+      unsigned
+      apply(Game& g);
+
+    private:
+
+      /**
+       * @brief - Used to make the slot at the input index available
+       *          to the producer.
+       * @param tail - the index of the slot to fill.
+       * @return - `true` if the slot is free.
+       */
+      bool
+      reserve(std::uint64_t tail) noexcept;
+
+    private:
+
+      /**
+       * @brief - The mask to convert an index to a slot.
+       */
+      std::uint64_t m_mask;
+
+      std::unique_ptr<Action[]> m_slots;
+
+      /**
+       * @brief - The index of the next action to pop, only written
+       *          by the consumer. It shares its cache line with the
+       *          consumer's copy of the last tail it read, so that
+       *          the tail is only loaded once the actions known to
+       *          be available are consumed.
+       */
+      alignas(64) std::atomic<std::uint64_t> m_head;
+      std::uint64_t m_cachedTail;
+
+      /**
+       * @brief - The index of the next action to push, only written
+       *          by the producer. It shares its cache line with the
+       *          producer's copy of the last head it read, so that
+       *          the head is only loaded when the queue seems full.
+       */
+      alignas(64) std::atomic<std::uint64_t> m_tail;
+      std::uint64_t m_cachedHead;
+  };
+
+}
+
+#endif    /* ACTION_QUEUE_HH */
@@ -0,0 +1,82 @@
+
+# include "DrawCommand.hh"
+
+namespace pge {
+  namespace menu {
+
+    DrawCommand
+    newRectCommand(const olc::vi2d& pos,
+                   const olc::vi2d& size,
+                   const olc::Pixel& color) noexcept
+    {
+      DrawCommand dc;
+
+      dc.primitive = Primitive::Rect;
+
+      dc.pos = pos;
+      dc.color = color;
+      dc.size = size;
+
+      dc.text = nullptr;
+
+      dc.decal = nullptr;
+      dc.source = olc::vi2d();
+
+      return dc;
+    }
+
+    DrawCommand
+    newTextCommand(const olc::vi2d& pos,
+                   const std::string& text,
+                   const olc::Pixel& color) noexcept
+    {
+      DrawCommand dc = newRectCommand(pos, olc::vi2d(), color);
+
+      dc.primitive = Primitive::Text;
+      dc.text = &text;
+
+      return dc;
+    }
+
+    DrawCommand
+    newSpriteCommand(const olc::vi2d& pos,
+                     olc::Decal* decal,
+                     const olc::vi2d& source,
+                     const olc::vf2d& scale) noexcept
+    {
+      DrawCommand dc = newRectCommand(pos, olc::vi2d(), olc::WHITE);
+
+      dc.primitive = Primitive::Sprite;
+      dc.size = scale;
+
+      dc.decal = decal;
+      dc.source = source;
+
+      return dc;
+    }
+
+    void
+    replay(olc::PixelGameEngine* pge,
+           const olc::vi2d& origin,
+           const DrawCommands& commands)
+    {
+      for (const DrawCommand& dc : commands) {
+        const olc::vi2d p = origin + dc.pos;
+
+        switch (dc.primitive) {
+          case Primitive::Text:
+            pge->DrawStringDecal(p, *dc.text, dc.color);
+            break;
+          case Primitive::Sprite:
+            pge->DrawPartialDecal(p, dc.decal, olc::vi2d(), dc.source, dc.size);
+            break;
+          case Primitive::Rect:
+          default:
+            pge->FillRectDecal(p, dc.size, dc.color);
+            break;
+        }
+      }
+    }
+
+  }
+}
@@ -0,0 +1,97 @@
+#ifndef    DRAW_COMMAND_HH
+# define   DRAW_COMMAND_HH
+
+# include <string>
+# include <vector>
+# include "olcEngine.hh"
+
+namespace pge {
+  namespace menu {
+
+    /**
+     * @brief - The kind of primitive drawn by a command.
+     */
+    enum class Primitive {
+      Rect,
+      Text,
+      Sprite
+    };
+
+    /**
+     * @brief - Convenience structure describing a single draw call
+     *          of a menu, with everything already computed: it only
+     *          has to be submitted to the engine. The position is
+     *          relative to the menu owning the list of commands.
+     *          The text and decal are owned by the menu producing
+     *          the command and stay valid until the menu changes.
+     */
+    struct DrawCommand {
+      Primitive primitive;
+
+      olc::vi2d pos;
+      olc::Pixel color;
+
+      // The size of the rectangle or the scale of the sprite.
+      olc::vf2d size;
+
+      const std::string* text;
+
+      olc::Decal* decal;
+      olc::vi2d source;
+    };
+
+    using DrawCommands = std::vector<DrawCommand>;
+
+    /**
+     * @brief - Create a command filling a rectangle with a color.
+     * @param pos - the position of the top left corner.
+     * @param size - the size of the rectangle.
+     * @param color - the color of the rectangle.
+     * @return - the created command.
+     */
+    DrawCommand
+    newRectCommand(const olc::vi2d& pos,
+                   const olc::vi2d& size,
+                   const olc::Pixel& color) noexcept;
+
+    /**
+     * @brief - Create a command drawing a text.
+     * @param pos - the position of the text.
+     * @param text - the text to draw.
+     * @param color - the color of the text.
+     * @return - the created command.
+     */
+    DrawCommand
+    newTextCommand(const olc::vi2d& pos,
+                   const std::string& text,
+                   const olc::Pixel& color) noexcept;
+
+    /**
+     * @brief - Create a command drawing a decal.
+     * @param pos - the position of the top left corner.
+     * @param decal - the decal to draw.
+     * @param source - the size of the area of the decal to draw.
+     * @param scale - the scale to apply to the decal.
+     * @return - the created command.
+     */
+    DrawCommand
+    newSpriteCommand(const olc::vi2d& pos,
+                     olc::Decal* decal,
+                     const olc::vi2d& source,
+                     const olc::vf2d& scale) noexcept;
+
+    /**
+     * @brief - Submit the commands to the engine.
+     * @param pge - the engine to draw with.
+     * @param origin - the position of the menu owning the commands.
+     * @param commands - the commands to draw.
+     */
+    void
+    replay(olc::PixelGameEngine* pge,
+           const olc::vi2d& origin,
+           const DrawCommands& commands);
+
+  }
+}
+
+#endif    /* DRAW_COMMAND_HH */
@@ -1,5 +1,7 @@
 
 # include "Menu.hh"
+# include "Trace.hh"
+# include "Log.hh"
 
 namespace pge {
 
@@ -29,48 +31,178 @@ namespace pge {
     m_bg(bg),
     m_fg(fg),
     m_fgSprite(nullptr),
+    m_iconPending(false),
+    m_uploads(0u),
 
     m_layout(layout),
 
     m_parent(parent),
     m_children(),
 
-    m_callback()
+    m_action(),
+
+    m_dirty(true),
+    m_commands(),
+
+    m_layoutDirty(false),
+    m_layoutPending(false),
+
+    m_boundsDirty(true),
+    m_boundsMin(),
+    m_boundsMax(),
+
+    m_touched(false),
+
+    m_input(InputCache{false, 0, 0, menu::InputHandle{false, false}})
   {
-    setService("menu");
+    setService(LogService);
 
     loadFGTile();
   }
 
   void
-  Menu::render(olc::PixelGameEngine* pge) const {
+  Menu::render(olc::PixelGameEngine* pge) {
+    trace::Scope scope("Menu::render");
+
     // If the menu is not visible, do nothing.
     if (!m_state.visible) {
       return;
     }
 
+    layout();
+
+    // Icons decoded in the background are drawn with a
+    // placeholder until they are uploaded.
+    const unsigned uploads = textures::uploaded();
+    if (m_uploads != uploads) {
+      m_uploads = uploads;
+      refreshIcons();
+    }
+
+    // The commands are relative to this menu so that
+    // they stay valid when a parent moves it.
+    if (m_dirty) {
+      m_commands.clear();
+      flatten(pge, olc::vi2d(0, 0), m_commands);
+      m_dirty = false;
+    }
+
+    menu::replay(pge, absolutePosition(), m_commands);
+  }
+
+  void
+  Menu::flatten(olc::PixelGameEngine* pge,
+                const olc::vi2d& pos,
+                menu::DrawCommands& commands) const
+  {
+    if (!m_state.visible) {
+      return;
+    }
+
     // Render the uniform background for this menu.
-    olc::vi2d pos = absolutePosition();
     olc::Pixel c = m_bg.color;
     if ((m_state.clickable && m_state.highlighted) || (m_state.selectable && m_state.selected)) {
       c = m_bg.hColor;
     }
-    pge->FillRectDecal(pos, m_size, c);
+    commands.push_back(menu::newRectCommand(pos, m_size, c));
 
     // Render this menu.
-    renderSelf(pge);
+    renderSelf(pge, pos, commands);
 
     // And then draw children in the order there were
     // added: it means that the last added menu will
-    // be repainted on top of the others.
+    // be repainted on top of the others. Positions
+    // are truncated as in `absolutePosition`.
+    for (unsigned id = 0u ; id < m_children.size() ; ++id) {
+      const olc::vi2d cp = m_children[id]->m_pos;
+      m_children[id]->flatten(pge, pos + cp, commands);
+    }
+  }
+
+  void
+  Menu::invalidate() noexcept {
+    // Parents include the commands of this menu in
+    // their own lists.
+    // The result of the inputs may also change.
+    for (const Menu* m = this ; m != nullptr ; m = m->m_parent) {
+      m->m_dirty = true;
+      m->m_input.valid = false;
+    }
+  }
+
+  void
+  Menu::invalidateBounds() noexcept {
+    for (const Menu* m = this ; m != nullptr && !m->m_boundsDirty ; m = m->m_parent) {
+      m->m_boundsDirty = true;
+    }
+  }
+
+  void
+  Menu::requestLayout() noexcept {
+    m_layoutDirty = true;
+
+    // Mark the path from the root so that it can be
+    // found without visiting the other branches.
+    for (Menu* m = this ; m != nullptr && !m->m_layoutPending ; m = m->m_parent) {
+      m->m_layoutPending = true;
+    }
+
+    invalidate();
+  }
+
+  void
+  Menu::layout() {
+    if (!m_layoutPending) {
+      return;
+    }
+
+    m_layoutPending = false;
+
+    // Parents first as they define the size of their
+    // children, which is used for the next levels.
+    if (m_layoutDirty) {
+      m_layoutDirty = false;
+      updateChildren();
+    }
+
     for (unsigned id = 0u ; id < m_children.size() ; ++id) {
-      m_children[id]->render(pge);
+      m_children[id]->layout();
     }
   }
 
   menu::InputHandle
   Menu::processUserInput(const controls::State& c,
-                         std::vector<ActionShPtr>& actions)
+                         ActionQueue& actions)
+  {
+    // In case the menu is not visible, do nothing.
+    if (!m_state.visible) {
+      return menu::InputHandle{false, false};
+    }
+
+    // Positions should be up to date to find the menu
+    // under the mouse.
+    layout();
+
+    // Without a click the state of the menus only
+    // depends on the position of the mouse.
+    bool click = (c.buttons[controls::mouse::Left] == controls::ButtonState::Released);
+    if (!click && m_input.valid && m_input.x == c.mPosX && m_input.y == c.mPosY) {
+      return m_input.res;
+    }
+
+    // The result of a click is not kept as the next
+    // frames do not report the selection anymore.
+    menu::InputHandle res = processInput(c, actions, absolutePosition(), click);
+    m_input = InputCache{!click, c.mPosX, c.mPosY, res};
+
+    return res;
+  }
+
+  menu::InputHandle
+  Menu::processInput(const controls::State& c,
+                     ActionQueue& actions,
+                     const olc::vi2d& ap,
+                     bool click)
   {
     menu::InputHandle res{false, false};
 
@@ -79,15 +211,39 @@ namespace pge {
       return res;
     }
 
+    // In case the mouse is not over this menu nor any
+    // of its children, none of them is relevant.
+    updateBounds();
+    if (c.mPosX < ap.x + m_boundsMin.x || c.mPosX >= ap.x + m_boundsMax.x ||
+        c.mPosY < ap.y + m_boundsMin.y || c.mPosY >= ap.y + m_boundsMax.y)
+    {
+      resetInput(click);
+      return res;
+    }
+
     // Make sure that the children get their chance
     // to process the event.
+    bool touched = false;
     for (unsigned id = 0u ; id < m_children.size() ; ++id) {
-      menu::InputHandle rc = m_children[id]->processUserInput(c, actions);
+      const olc::vi2d cp = m_children[id]->m_pos;
+      menu::InputHandle rc = m_children[id]->processInput(c, actions, ap + cp, click);
 
       res.relevant = res.relevant || rc.relevant;
       res.selected = res.selected || rc.selected;
+      touched = touched || m_children[id]->m_touched;
     }
 
+    // Colors depend on the highlight and selection so
+    // the commands need to be updated if they change.
+    const State prev = m_state;
+    const auto changed = [this, &prev, touched]() {
+      if (prev.highlighted != m_state.highlighted || prev.selected != m_state.selected) {
+        invalidate();
+      }
+
+      m_touched = touched || m_state.highlighted || m_state.selected;
+    };
+
     // If the mouse is not inside this element, stop
     // the process here: children still got a chance
     // to update their state with this event. And no
@@ -96,9 +252,6 @@ namespace pge {
     // following conditions apply: it either mean
     // that the mouse is not inside this menu or
     // that a child is more relevant than we are.
-    bool click = (c.buttons[controls::mouse::Left] == controls::ButtonState::Released);
-
-    olc::vi2d ap = absolutePosition();
     if (c.mPosX < ap.x || c.mPosX >= ap.x + m_size.x ||
         c.mPosY < ap.y || c.mPosY >= ap.y + m_size.y ||
         res.relevant || res.selected)
@@ -109,6 +262,7 @@ namespace pge {
         m_state.selected = false;
       }
 
+      changed();
       return res;
     }
 
@@ -134,11 +288,90 @@ namespace pge {
       res.selected = true;
     }
 
+    changed();
     return res;
   }
 
+  void
+  Menu::resetInput(bool click) {
+    if (!m_touched) {
+      return;
+    }
+
+    const State prev = m_state;
+
+    m_state.highlighted = false;
+    if (click) {
+      m_state.selected = false;
+    }
+
+    if (prev.highlighted != m_state.highlighted || prev.selected != m_state.selected) {
+      invalidate();
+    }
+
+    // Hidden children do not process inputs so their
+    // state is kept.
+    bool touched = false;
+    for (unsigned id = 0u ; id < m_children.size() ; ++id) {
+      if (m_children[id]->m_state.visible) {
+        m_children[id]->resetInput(click);
+      }
+
+      touched = touched || m_children[id]->m_touched;
+    }
+
+    m_touched = touched || m_state.selected;
+  }
+
+  void
+  Menu::updateBounds() {
+    if (!m_boundsDirty) {
+      return;
+    }
+
+    m_boundsDirty = false;
+
+    m_boundsMin = olc::vi2d(0, 0);
+    m_boundsMax = m_size;
+
+    for (unsigned id = 0u ; id < m_children.size() ; ++id) {
+      Menu& child = *m_children[id];
+      if (!child.m_state.visible) {
+        continue;
+      }
+
+      child.updateBounds();
+
+      const olc::vi2d cp = child.m_pos;
+      m_boundsMin.x = std::min(m_boundsMin.x, cp.x + child.m_boundsMin.x);
+      m_boundsMin.y = std::min(m_boundsMin.y, cp.y + child.m_boundsMin.y);
+      m_boundsMax.x = std::max(m_boundsMax.x, cp.x + child.m_boundsMax.x);
+      m_boundsMax.y = std::max(m_boundsMax.y, cp.y + child.m_boundsMax.y);
+    }
+  }
+
   void
   Menu::addMenu(MenuShPtr child) {
+    attach(child);
+
+    // Update properties of each child in response
+    // to the new child.
+    requestLayout();
+  }
+
+  void
+  Menu::addMenus(const std::vector<MenuShPtr>& children) {
+    m_children.reserve(m_children.size() + children.size());
+
+    for (unsigned id = 0u ; id < children.size() ; ++id) {
+      attach(children[id]);
+    }
+
+    requestLayout();
+  }
+
+  void
+  Menu::attach(MenuShPtr child) {
     // Check consistency.
     if (child == nullptr) {
       return;
@@ -159,26 +392,29 @@ namespace pge {
     child->m_parent = this;
 
     m_children.push_back(child);
-
-    // Update properties of each child in response
-    // to the new child.
-    updateChildren();
   }
 
   void
-  Menu::setAction(menu::RegisterAction action) {
-    m_callback = action;
+  Menu::setAction(Action&& action) {
+    m_action = std::move(action);
   }
 
   void
-  Menu::setSimpleAction(action::Process process) {
-    m_callback = [process](std::vector<ActionShPtr>& actions) {
-      actions.push_back(std::make_shared<Action>(process));
-    };
+  Menu::onClick(ActionQueue& actions) const {
+    // Trigger the action if it is defined: the queue only
+    // receives a handle to the action of the menu so that
+    // what it captured is not copied on each click.
+    const Action* action = &m_action;
+    if (m_action && !actions.push(Action([action](Game& g) { action->apply(g); }))) {
+      PGE_WARN("Dropping action, ", actions.capacity(), " action(s) already pending");
+    }
   }
 
   void
-  Menu::renderSelf(olc::PixelGameEngine* pge) const {
+  Menu::renderSelf(olc::PixelGameEngine* pge,
+                   const olc::vi2d& pos,
+                   menu::DrawCommands& commands) const
+  {
     // We need to display both the text and the icon
     // if needed. We assume the content will always
     // be centered along the perpendicular axis for
@@ -192,7 +428,7 @@ namespace pge {
       return;
     }
 
-    olc::vi2d ap = absolutePosition();
+    const olc::vi2d& ap = pos;
 
     if (m_fg.text != "" && m_fgSprite == nullptr) {
       olc::vi2d ts = pge->GetTextSize(m_fg.text);
@@ -226,7 +462,7 @@ namespace pge {
         c = m_fg.hColor;
       }
 
-      pge->DrawStringDecal(p, m_fg.text, c);
+      commands.push_back(menu::newTextCommand(p, m_fg.text, c));
 
       return;
     }
@@ -242,7 +478,7 @@ namespace pge {
       olc::vi2d ss(m_fgSprite->sprite->width, m_fgSprite->sprite->height);
       olc::vf2d s(1.0f * m_fg.size.x / ss.x, 1.0f * m_fg.size.y / ss.y);
 
-      pge->DrawPartialDecal(p, m_fgSprite, olc::vi2d(), ss, s);
+      commands.push_back(menu::newSpriteCommand(p, m_fgSprite.get(), ss, s));
 
       return;
     }
@@ -344,9 +580,8 @@ namespace pge {
       c = m_fg.hColor;
     }
 
-    pge->DrawStringDecal(tp, m_fg.text, c);
-
-    pge->DrawPartialDecal(sp, m_fgSprite, olc::vi2d(), ss, s);
+    commands.push_back(menu::newTextCommand(tp, m_fg.text, c));
+    commands.push_back(menu::newSpriteCommand(sp, m_fgSprite.get(), ss, s));
   }
 
   void
@@ -360,9 +595,22 @@ namespace pge {
     m_fg.size.x = std::max(m_fg.size.x, 10);
     m_fg.size.y = std::max(m_fg.size.y, 10);
 
-    // Load the sprite.
-    olc::Sprite* spr = new olc::Sprite(m_fg.icon);
-    m_fgSprite = new olc::Decal(spr);
+    // Load the sprite: it is only decoded once for all
+    // the menus using it.
+    m_fgSprite = textures::texture(m_fg.icon);
+    m_iconPending = textures::pending(m_fgSprite);
+  }
+
+  void
+  Menu::refreshIcons() noexcept {
+    if (m_iconPending && !textures::pending(m_fgSprite)) {
+      m_iconPending = false;
+      invalidate();
+    }
+
+    for (unsigned id = 0u ; id < m_children.size() ; ++id) {
+      m_children[id]->refreshIcons();
+    }
   }
 
   void
@@ -390,12 +638,11 @@ namespace pge {
     }
 
     if (expandableSize < 0) {
-      log(
-        "Menu has " + std::to_string(m_children.size()) + " child(ren)" +
-        " occpupying " + std::to_string(i - expandableSize) +
-        " but menu is only " + std::to_string(i) +
-        ", truncation will occur",
-        utils::Level::Warning
+      PGE_WARN(
+        "Menu has ", m_children.size(), " child(ren)",
+        " occpupying ", i - expandableSize,
+        " but menu is only ", i,
+        ", truncation will occur"
       );
 
       expandableSize = 0;
@@ -410,7 +657,15 @@ namespace pge {
     float offset = 0.0f;
     float delta = 0.0f;
 
+    // The size of the children changes so their own
+    // commands are not valid anymore.
+    invalidate();
+    invalidateBounds();
+
     for (unsigned id = 0u ; id < m_children.size() ; ++id) {
+      m_children[id]->m_dirty = true;
+      m_children[id]->m_boundsDirty = true;
+
       switch (m_layout) {
         case menu::Layout::Vertical:
           m_children[id]->m_size.x = std::min(m_children[id]->m_size.x, wh);
@@ -5,10 +5,13 @@
 # include <vector>
 # include <core_utils/CoreObject.hh>
 # include "olcEngine.hh"
+# include "Textures.hh"
 # include "BackgroundDesc.hh"
 # include "MenuContentDesc.hh"
+# include "DrawCommand.hh"
 # include "Controls.hh"
 # include "Action.hh"
+# include "ActionQueue.hh"
 
 namespace pge {
 
@@ -40,14 +43,6 @@ namespace pge {
       bool selected;
     };
 
-    /**
-     * @brief - Defines a common function called whenever
-     *          the menu is clicked upon. This allows to
-     *          specialize the menu class easily when not
-     *          much is needed.
-     */
-    using RegisterAction = std::function<void(std::vector<ActionShPtr>&)>;
-
   }
 
   class Menu: public utils::CoreObject {
@@ -146,15 +141,23 @@ namespace pge {
        *         and hide the internal complexity of the menu.
        *         Note: we draw on the active layer so it has
        *         to be configured before calling this method.
+       *         The draw calls of the menu and its children
+       *         are kept from one frame to the next and only
+       *         computed again when one of them changes. The
+       *         pending layouts are applied beforehand.
        * @param pge - the rendering engine to display the menu.
        */
       void
-      render(olc::PixelGameEngine* pge) const;
+      render(olc::PixelGameEngine* pge);
 
       /**
        * @brief - Used to process the user input defined in
        *          the argument and update the internal state
-       *          of this menu if needed.
+       *          of this menu if needed. The children which
+       *          are not under the mouse are skipped, and the
+       *          inputs are not processed again as long as the
+       *          mouse does not move or click and the menus
+       *          do not change.
        * @param c - the controls and user input for this
        *            frame.
        * @param actions - the list of actions produced by the
@@ -164,17 +167,43 @@ namespace pge {
        */
       menu::InputHandle
       processUserInput(const controls::State& c,
-                       std::vector<ActionShPtr>& actions);
+                       ActionQueue& actions);
 
       /**
-       * @brief - Adds the input menu as a child of this one.
+       * @brief - Adds the input menu as a child of this one. The
+       *          layout of the children is deferred until the menu
+       *          is rendered or processes inputs (see `layout`) so
+       *          that adding several children only requires a
+       *          single layout pass.
        * @param child - the child menu to register.
        */
       void
       addMenu(MenuShPtr child);
 
       /**
-       * @brief - Retrieve the size for this menu.
+       * @brief - Adds all the input menus as children of this one,
+       *          in order. Similar to calling `addMenu` for each of
+       *          them but only reserves the space once.
+       * @param children - the children menus to register.
+       */
+      void
+      addMenus(const std::vector<MenuShPtr>& children);
+
+      /**
+       * @brief - Apply the layouts requested for this menu and its
+       *          children since the last call. Only the branches
+       *          with a pending layout are traversed. This is done
+       *          automatically before rendering and processing the
+       *          inputs, but can be used to access the final size
+       *          of the menus right after building them.
+       */
+      void
+      layout();
+
+      /**
+       * @brief - Retrieve the size for this menu. Note that the
+       *          size is only updated when the layout is applied
+       *          (see `layout`).
        * @return - the size of this menu in pixels.
        */
       olc::vf2d
@@ -190,7 +219,9 @@ namespace pge {
 
       /**
        * @brief - Replace the existing background content with
-       *          the new one.
+       *          the new one. The layout of the parent is only
+       *          updated if the scaling of the background is
+       *          changed: colors only affect the appearance.
        * @param bg - the new background description.
        */
       void
@@ -198,6 +229,8 @@ namespace pge {
 
       /**
        * @brief - Replace the existing content with the new one.
+       *          The layout of the parent is updated if the size
+       *          of the content changes.
        * @param mcd - the new content description for this menu.
        */
       void
@@ -206,41 +239,84 @@ namespace pge {
       /**
        * @brief - Replace the existing text with the new one. It
        *          will keep every other foreground properties in
-       *          a similar state.
+       *          a similar state. The text is not considered by
+       *          the layout so only the appearance changes.
        */
       void
       setText(const std::string& text);
 
       /**
-       * @brief - Assigns a new action attached to this menu.
+       * @brief - Assigns a new action attached to this menu: it
+       *          is kept by the menu and an action referring to
+       *          it is pushed to the queue whenever the menu is
+       *          clicked upon. The menu should thus outlive the
+       *          actions it pushed.
        * @param action - the action attached to the menu.
        */
       void
-      setAction(menu::RegisterAction action);
+      setAction(Action&& action);
 
       /**
-       * @brief - Used to define a new simple action where the
-       *          process would be to push the input callback
-       *          to the provided vector of actions.
-       * @param process - the callback to be pushed to the list
-       *                  of action whenever the callback linked
-       *                  to this menu is triggered.
+       * @brief - Used to define a new simple action from the
+       *          input process, which is triggered with the game
+       *          whenever this menu is clicked upon.
+       * @param process - the callable applied to the game.
        */
+      template <typename Process>
       void
-      setSimpleAction(action::Process process);
+      setSimpleAction(Process&& process);
 
     protected:
 
+      /**
+       * @brief - The service of the messages of this class, given
+       *          to `setService` and to the logging macros.
+       */
+      static constexpr const char* LogService = "menu";
+
       /**
        * @brief - Interface method allowing inheriting classes
        *          to perform their own drawing routines on top
-       *          of the base representation of the menu.
-       *          This default implementation does nothing.
+       *          of the base representation of the menu. The
+       *          draw calls are registered as commands which
+       *          are replayed until the menu is invalidated.
+       *          This default implementation draws the text
+       *          and icon of the menu.
        * @param pge - the rendering engine to display the menu.
+       * @param pos - the position of the menu relatively to the
+       *              first menu of the list of commands.
+       * @param commands - output list to register commands.
        */
       virtual
       void
-      renderSelf(olc::PixelGameEngine* pge) const;
+      renderSelf(olc::PixelGameEngine* pge,
+                 const olc::vi2d& pos,
+                 menu::DrawCommands& commands) const;
+
+      /**
+       * @brief - Used to indicate that the appearance of this menu
+       *          changed: the draw commands of this menu and of its
+       *          parents will be computed again on the next render.
+       */
+      void
+      invalidate() noexcept;
+
+      /**
+       * @brief - Used to indicate that the area covered by this
+       *          menu changed, which is also the case for all its
+       *          parents.
+       */
+      void
+      invalidateBounds() noexcept;
+
+      /**
+       * @brief - Used to indicate that the children of this menu
+       *          need to be laid out again. This is deferred to
+       *          the next call to `layout` so that several changes
+       *          only trigger a single update.
+       */
+      void
+      requestLayout() noexcept;
 
       /**
        * @brief - Interface method allowing inheriting classes
@@ -249,12 +325,12 @@ namespace pge {
        *          For now this method is only triggered when a
        *          click witht he left mouse button is detected.
        *          The default implementation does nothing.
-       * @param actions - output vector to register actions if
+       * @param actions - output queue to register actions if
        *                  needed.
        */
       virtual
       void
-      onClick(std::vector<ActionShPtr>& actions) const;
+      onClick(ActionQueue& actions) const;
 
       /**
        * @brief - Interface method called right before this menu
@@ -294,6 +370,14 @@ namespace pge {
 
     private:
 
+      /**
+       * @brief - Register the input menu as a child of this one
+       *          without updating the layout.
+       * @param child - the child menu to register.
+       */
+      void
+      attach(MenuShPtr child);
+
       /**
        * @brief - Used to perform the loaded of the foreground tile
        *          used by this menu (i.e. the content tile).
@@ -301,6 +385,14 @@ namespace pge {
       void
       loadFGTile();
 
+      /**
+       * @brief - Invalidate the menus in the hierarchy starting at
+       *          this one whose icon was uploaded since it was drawn
+       *          with the placeholder.
+       */
+      void
+      refreshIcons() noexcept;
+
       /**
        * @brief - Clear any loaded resource for this menu. Used
        *          when the visual appearance needs to be adjusted.
@@ -323,6 +415,52 @@ namespace pge {
       void
       updateChildren();
 
+      /**
+       * @brief - Implementation of the processing of the inputs for
+       *          this menu and its children.
+       * @param c - the controls and user input for this frame.
+       * @param actions - the list of actions produced by the menu.
+       * @param pos - the absolute position of this menu.
+       * @param click - whether the left mouse button was clicked.
+       * @return - the description of what happened.
+       */
+      menu::InputHandle
+      processInput(const controls::State& c,
+                   ActionQueue& actions,
+                   const olc::vi2d& pos,
+                   bool click);
+
+      /**
+       * @brief - Reset the highlight (and the selection in case of
+       *          a click) of this menu and its visible children as
+       *          when the mouse is not over any of them. Branches
+       *          where no menu is highlighted or selected are not
+       *          visited.
+       * @param click - whether the left mouse button was clicked.
+       */
+      void
+      resetInput(bool click);
+
+      /**
+       * @brief - Compute again the area covered by this menu and its
+       *          visible children if it changed.
+       */
+      void
+      updateBounds();
+
+      /**
+       * @brief - Register the draw commands of this menu and of its
+       *          visible children in the output list.
+       * @param pge - the rendering engine used to measure texts.
+       * @param pos - the position of this menu relatively to the
+       *              first menu of the list.
+       * @param commands - the output list of commands.
+       */
+      void
+      flatten(olc::PixelGameEngine* pge,
+              const olc::vi2d& pos,
+              menu::DrawCommands& commands) const;
+
     private:
 
       /**
@@ -385,9 +523,18 @@ namespace pge {
       /**
        * @brief - Hold the sprite used as an icon for this menu. It
        *          might be `null` in case none is used in the menu's
-       *          content.
+       *          content. It is shared with the menus using the same
+       *          icon.
        */
-      olc::Decal* m_fgSprite;
+      TextureShPtr m_fgSprite;
+
+      /**
+       * @brief - Whether the icon was still being decoded when this
+       *          menu was loaded, and the number of textures uploaded
+       *          as of the last check of the icons of the hierarchy.
+       */
+      bool m_iconPending;
+      unsigned m_uploads;
 
       /**
        * @brief - The layout for this menu. Allow to define how the
@@ -409,10 +556,61 @@ namespace pge {
       std::vector<MenuShPtr> m_children;
 
       /**
-       * @brief - The callback to trigger whenver this menu is
+       * @brief - The action to trigger whenver this menu is
        *          clicked upon.
        */
-      menu::RegisterAction m_callback;
+      Action m_action;
+
+      /**
+       * @brief - Whether the draw commands need to be computed again
+       *          and the commands to draw this menu and its children
+       *          as of the last render.
+       */
+      mutable bool m_dirty;
+      mutable menu::DrawCommands m_commands;
+
+      /**
+       * @brief - Whether the children of this menu should be laid
+       *          out again, and whether this is the case for this
+       *          menu or any of its children.
+       */
+      bool m_layoutDirty;
+      bool m_layoutPending;
+
+      /**
+       * @brief - The area covered by this menu and its visible
+       *          children, relatively to the position of the menu.
+       *          It is used to skip the children when the mouse is
+       *          not over them.
+       */
+      mutable bool m_boundsDirty;
+      olc::vi2d m_boundsMin;
+      olc::vi2d m_boundsMax;
+
+      /**
+       * @brief - Whether this menu or any of its children is either
+       *          highlighted or selected: the state of the others is
+       *          already reset.
+       */
+      bool m_touched;
+
+      /**
+       * @brief - Convenience structure keeping the result of the
+       *          processing of the inputs along with the position
+       *          of the mouse used to compute it.
+       */
+      struct InputCache {
+        // Whether the result can be reused: it is reset
+        // whenever the menus change.
+        bool valid;
+
+        int x;
+        int y;
+
+        menu::InputHandle res;
+      };
+
+      mutable InputCache m_input;
   };
 
 }
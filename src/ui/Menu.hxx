@@ -21,24 +21,35 @@ namespace pge {
   void
   Menu::setVisible(bool visible) noexcept {
     m_state.visible = visible;
+    invalidate();
+
+    // Hidden menus do not cover any area.
+    if (m_parent != nullptr) {
+      m_parent->invalidateBounds();
+    }
   }
 
   inline
   void
   Menu::setClickable(bool click) noexcept {
     m_state.clickable = click;
+    invalidate();
   }
 
   inline
   void
   Menu::setSelectable(bool select) noexcept {
     m_state.selectable = select;
+    invalidate();
   }
 
   inline
   void
   Menu::setEnabled(bool enabled) noexcept {
     m_state.enabled = enabled;
+
+    // Disabled menus are not highlighted anymore.
+    invalidate();
   }
 
   inline
@@ -62,24 +73,36 @@ namespace pge {
   inline
   void
   Menu::setBackground(const menu::BackgroundDesc& bg) {
+    // Only the scaling is used by the layout.
+    const bool resized = (bg.scale != m_bg.scale);
+
     m_bg = bg;
+    invalidate();
 
     // Update the parent's display if possible.
-    if (m_parent != nullptr) {
-      m_parent->updateChildren();
+    if (resized && m_parent != nullptr) {
+      m_parent->requestLayout();
     }
   }
 
   inline
   void
   Menu::setContent(const menu::MenuContentDesc& mcd) {
+    // The text and colors do not change the layout.
+    const bool resized = (
+      mcd.expand != m_fg.expand ||
+      mcd.icon != m_fg.icon ||
+      mcd.size != m_fg.size
+    );
+
     clearContent();
     m_fg = mcd;
     loadFGTile();
+    invalidate();
 
     // Update the parent's display if possible.
-    if (m_parent != nullptr) {
-      m_parent->updateChildren();
+    if (resized && m_parent != nullptr) {
+      m_parent->requestLayout();
     }
   }
 
@@ -87,20 +110,7 @@ namespace pge {
   void
   Menu::setText(const std::string& text) {
     m_fg.text = text;
-
-    // Update the parent's display if possible.
-    if (m_parent != nullptr) {
-      m_parent->updateChildren();
-    }
-  }
-
-  inline
-  void
-  Menu::onClick(std::vector<ActionShPtr>& actions) const {
-    // Trigger the callback if it is defined.
-    if (m_callback) {
-      m_callback(actions);
-    }
+    invalidate();
   }
 
   inline
@@ -135,6 +145,13 @@ namespace pge {
     return m_fg;
   }
 
+  template <typename Process>
+  inline
+  void
+  Menu::setSimpleAction(Process&& process) {
+    setAction(Action(std::forward<Process>(process)));
+  }
+
   inline
   void
   Menu::clear() {}
@@ -142,11 +159,8 @@ namespace pge {
   inline
   void
   Menu::clearContent() {
-    if (m_fgSprite != nullptr) {
-      delete m_fgSprite;
-    }
-
-    m_fgSprite = nullptr;
+    m_fgSprite.reset();
+    m_iconPending = false;
   }
 
 }